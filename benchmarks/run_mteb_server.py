@@ -29,16 +29,30 @@ TASKS = [
 
 os.environ["TOKENIZERS_PARALLELISM"] = "false" # Get rid of the warning spam.
 
+def recv_exact(sock, n):
+    buf = bytearray()
+    while len(buf) < n:
+        chunk = sock.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("server closed the connection")
+        buf += chunk
+    return bytes(buf)
+
 class CppEmbeddingsServerModel():
     def __init__(self, socket):
         self.socket = socket
     def encode(self, sentences, batch_size=32, **kwargs):
+        # one batch encode request (type 2) per batch_size sentences, f32 results
         results = []
-        for s in sentences:
-            self.socket.sendall(s.encode())
-            data = self.socket.recv(N_EMBD*4)
-            floats = struct.unpack('f' * N_EMBD, data)
-            results.append(np.array(floats))
+        for start in range(0, len(sentences), batch_size):
+            chunk = [s.encode() for s in sentences[start:start + batch_size]]
+            payload = struct.pack('<I', len(chunk)) + b''.join(struct.pack('<I', len(s)) + s for s in chunk)
+            self.socket.sendall(struct.pack('<IHH', len(payload), 2, 0) + payload)
+            size, status, flags = struct.unpack('<IHH', recv_exact(self.socket, 8))
+            data = recv_exact(self.socket, size)
+            if status != 0:
+                raise RuntimeError(f"request failed with status {status}")
+            results.extend(np.frombuffer(data, dtype='<f4').reshape(len(chunk), N_EMBD))
         return results
     
 class BatchlessModel():
@@ -1,7 +1,9 @@
 #include "bert.h"
 #include "ggml.h"
+#include "unicode_data.h"
 
 #include <cassert>
+#include <cctype>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -10,9 +12,37 @@
 #include <string>
 #include <vector>
 #include <iostream>
-#include <regex>
+#include <list>
+#include <string_view>
+#include <unordered_map>
 #include <thread>
 #include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(_POSIX_MAPPED_FILES) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BERT_USE_MMAP
+#endif
+
+#if defined(__AVX__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // default hparams (all-MiniLM-L6-v2)
 struct bert_hparams
@@ -35,7 +65,10 @@ struct bert_layer
     struct ggml_tensor *ln_out_w;
     struct ggml_tensor *ln_out_b;
 
-    // attention
+    // attention, q/k/v are views into the fused qkv tensors
+    struct ggml_tensor *qkv_w;
+    struct ggml_tensor *qkv_b;
+
     struct ggml_tensor *q_w;
     struct ggml_tensor *q_b;
     struct ggml_tensor *k_w;
@@ -54,13 +87,232 @@ struct bert_layer
     struct ggml_tensor *ff_o_b;
 };
 
+// FNV-1a, h is the offset basis
+static uint64_t bert_hash(std::string_view text, uint64_t h = 0xcbf29ce484222325ull)
+{
+    for (unsigned char c : text)
+    {
+        h = (h ^ c) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// Byte trie of vocab tokens, stored flat. The edges of node i are edge_begin[i] .. edge_begin[i + 1],
+// sorted by byte.
+struct bert_trie
+{
+    std::vector<uint32_t> edge_begin;
+    std::vector<uint8_t> edge_byte;
+    std::vector<uint32_t> edge_node;
+    std::vector<bert_vocab_id> node_id; // token ending at the node, -1 if none
+
+    // tokens must be unique
+    void build(std::vector<std::pair<std::string_view, bert_vocab_id>> tokens)
+    {
+        std::sort(tokens.begin(), tokens.end());
+
+        // nodes are numbered breadth first, the tokens below a node are a range of the sorted tokens
+        struct pending
+        {
+            size_t begin, end, depth;
+        };
+        std::vector<pending> nodes = {{0, tokens.size(), 0}};
+
+        edge_begin.clear();
+        edge_byte.clear();
+        edge_node.clear();
+        node_id.clear();
+        for (size_t k = 0; k < nodes.size(); k++)
+        {
+            auto [begin, end, depth] = nodes[k];
+            node_id.push_back(-1);
+            if (begin < end && tokens[begin].first.size() == depth)
+            {
+                node_id.back() = tokens[begin].second;
+                begin++;
+            }
+            edge_begin.push_back(edge_byte.size());
+            while (begin < end)
+            {
+                const uint8_t c = tokens[begin].first[depth];
+                size_t next = begin + 1;
+                while (next < end && (uint8_t) tokens[next].first[depth] == c)
+                {
+                    next++;
+                }
+                edge_byte.push_back(c);
+                edge_node.push_back(nodes.size());
+                nodes.push_back({begin, next, depth + 1});
+                begin = next;
+            }
+        }
+        edge_begin.push_back(edge_byte.size());
+    }
+
+    // Length of the longest token that is a prefix of text, 0 if none
+    int longest_match(const char * text, int n, bert_vocab_id & id) const
+    {
+        int len = 0;
+        uint32_t node = 0;
+        for (int i = 0; i < n; i++)
+        {
+            const uint8_t * first = edge_byte.data() + edge_begin[node];
+            const uint8_t * last = edge_byte.data() + edge_begin[node + 1];
+            const uint8_t * edge = std::lower_bound(first, last, (uint8_t) text[i]);
+            if (edge == last || *edge != (uint8_t) text[i])
+            {
+                break;
+            }
+            node = edge_node[edge - edge_byte.data()];
+            if (node_id[node] >= 0)
+            {
+                id = node_id[node];
+                len = i + 1;
+            }
+        }
+        return len;
+    }
+};
+
+// All tokens in one buffer, token i is text[offsets[i]] .. text[offsets[i + 1] - 1] and NUL terminated
 struct bert_vocab
 {
-    std::map<std::string, bert_vocab_id> token_to_id;
-    std::map<std::string, bert_vocab_id> subword_token_to_id;
+    std::string text;
+    std::vector<uint32_t> offsets;
+
+    // open addressing hash table of token -> id, -1 for empty slots
+    std::vector<bert_vocab_id> index;
+
+    // whole tokens and ## continuation tokens (without ##) compiled for matching
+    bert_trie token_trie;
+    bert_trie subword_token_trie;
+
+    int32_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    std::string_view token(bert_vocab_id id) const
+    {
+        return std::string_view(text.data() + offsets[id], offsets[id + 1] - offsets[id] - 1);
+    }
+
+    // Id of the first occurrence of token, -1 if it isn't in the vocab
+    bert_vocab_id find(std::string_view token) const
+    {
+        const size_t mask = index.size() - 1;
+        for (size_t slot = bert_hash(token) & mask; index[slot] >= 0; slot = (slot + 1) & mask)
+        {
+            if (this->token(index[slot]) == token)
+            {
+                return index[slot];
+            }
+        }
+        return -1;
+    }
+
+    // Builds the index and the tries once all tokens are in text and offsets
+    void build()
+    {
+        const int32_t n_vocab = size();
+        size_t n_slots = 16;
+        while (n_slots < 2 * size_t(n_vocab))
+        {
+            n_slots *= 2;
+        }
+        index.assign(n_slots, -1);
+
+        std::vector<std::pair<std::string_view, bert_vocab_id>> tokens;
+        std::vector<std::pair<std::string_view, bert_vocab_id>> subword_tokens;
+        for (bert_vocab_id id = 0; id < n_vocab; id++)
+        {
+            const std::string_view tok = token(id);
+            if (find(tok) >= 0)
+            {
+                // duplicates keep their first id
+                continue;
+            }
+            size_t slot = bert_hash(tok) & (n_slots - 1);
+            while (index[slot] >= 0)
+            {
+                slot = (slot + 1) & (n_slots - 1);
+            }
+            index[slot] = id;
+
+            tokens.emplace_back(tok, id);
+            if (tok.size() >= 2 && tok[0] == '#' && tok[1] == '#')
+            {
+                subword_tokens.emplace_back(tok.substr(2), id);
+            }
+        }
+
+        token_trie.build(std::move(tokens));
+        subword_token_trie.build(std::move(subword_tokens));
+    }
+};
+
+// Read-only mapping of a model file, tensors of the model point straight into it
+struct bert_mmap
+{
+    void * addr = nullptr;
+    size_t size = 0;
+
+#ifdef BERT_USE_MMAP
+    static constexpr bool supported = true;
+
+    bool map(const char * fname, bool prefetch)
+    {
+        int fd = open(fname, O_RDONLY);
+        if (fd == -1)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            close(fd);
+            return false;
+        }
+        size = st.st_size;
+
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if (prefetch)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        addr = mmap(NULL, size, PROT_READ, flags, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            addr = nullptr;
+            return false;
+        }
+#ifndef MAP_POPULATE
+        if (prefetch)
+        {
+            posix_madvise(addr, size, POSIX_MADV_WILLNEED);
+        }
+#endif
+        return true;
+    }
+
+    ~bert_mmap()
+    {
+        if (addr)
+        {
+            munmap(addr, size);
+        }
+    }
+#else
+    static constexpr bool supported = false;
 
-    std::map<bert_vocab_id, std::string> _id_to_token;
-    std::map<bert_vocab_id, std::string> _id_to_subword_token;
+    bool map(const char *, bool)
+    {
+        return false;
+    }
+#endif
 };
 
 struct bert_model
@@ -76,8 +328,11 @@ struct bert_model
 
     std::vector<bert_layer> layers;
 
-    struct ggml_context *ctx;
+    struct ggml_context *ctx = nullptr;
     std::map<std::string, struct ggml_tensor *> tensors;
+
+    // set when the weights are mapped from the model file instead of read
+    std::unique_ptr<bert_mmap> mapping;
 };
 
 // Replacement for std::vector<uint8_t> that doesn't require zero-initialization.
@@ -96,241 +351,1551 @@ struct bert_buffer {
     }
 };
 
-
-struct bert_ctx
-{
-    bert_model model;
-    bert_vocab vocab;
-
-    size_t mem_per_token;
-    int64_t mem_per_input;
-    int32_t max_batch_n;
-    bert_buffer buf_compute;
-};
-
-int32_t bert_n_embd(bert_ctx * ctx)
-{
-    return ctx->model.hparams.n_embd;
-}
-
-int32_t bert_n_max_tokens(bert_ctx * ctx)
+// Persistent worker threads of a state that tokenize batches. Graph evaluation doesn't use them, the
+// pinned ggml starts its own threads in every ggml_graph_compute and has no way to run nodes on others.
+// Idle workers spin for spin_us microseconds before going to sleep on a condition variable.
+struct bert_threadpool
 {
-    return ctx->model.hparams.n_max_tokens;
-}
-
-const char* bert_vocab_id_to_token(bert_ctx * ctx, bert_vocab_id id) {
-    bert_vocab & vocab = ctx->vocab;
-    auto it = vocab._id_to_token.find(id);
-    if (it != vocab._id_to_token.end())
+    std::vector<std::thread> workers;
+    int32_t spin_us = 0;
+    bool pin_threads = false;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<int64_t> generation{0};
+    std::atomic<int32_t> n_pending{0};
+    bool stop = false;
+    std::function<void(int, int)> task;
+
+    void start(int32_t n_threads, int32_t spin_us, bool pin_threads)
     {
-        return it->second.c_str();
+        this->spin_us = spin_us;
+        this->pin_threads = pin_threads;
+        for (int ith = 1; ith < n_threads; ith++)
+        {
+            workers.emplace_back([this, ith] { worker(ith); });
+        }
+#if defined(__linux__)
+        if (pin_threads)
+        {
+            for (size_t i = 0; i < workers.size(); i++)
+            {
+                pin(workers[i].native_handle(), i + 1);
+            }
+        }
+#endif
     }
-    it = vocab._id_to_subword_token.find(id);
-    if (it != vocab._id_to_subword_token.end())
+
+    int32_t n_threads() const
     {
-        return it->second.c_str();
+        return workers.size() + 1;
     }
-    return "[UNK TOKEN from bert_vocab]";
-}
-
-//
-// Cli interface
-//
-
-void bert_print_usage(char **argv, const bert_params &params)
-{
-    fprintf(stderr, "usage: %s [options]\n", argv[0]);
-    fprintf(stderr, "\n");
-    fprintf(stderr, "options:\n");
-    fprintf(stderr, "  -h, --help            show this help message and exit\n");
-    fprintf(stderr, "  -s SEED, --seed SEED  RNG seed (default: -1)\n");
-    fprintf(stderr, "  -t N, --threads N     number of threads to use during computation (default: %d)\n", params.n_threads);
-    fprintf(stderr, "  -p PROMPT, --prompt PROMPT\n");
-    fprintf(stderr, "                        prompt to start generation with (default: random)\n");
-    fprintf(stderr, "  --port p     port to bind in server mode (default: %d)\n", params.port);
-    fprintf(stderr, "  -m FNAME, --model FNAME\n");
-    fprintf(stderr, "                        model path (default: %s)\n", params.model);
-    fprintf(stderr, "\n");
-}
-
 
-bool bert_params_parse(int argc, char **argv, bert_params &params)
-{
-    for (int i = 1; i < argc; i++)
+    // Runs fn(ith, nth) on every worker and the calling thread, returns when all are done
+    void run(const std::function<void(int, int)> & fn)
     {
-        std::string arg = argv[i];
-
-        if (arg == "-t" || arg == "--threads")
+        const int nth = n_threads();
+        if (nth > 1)
         {
-            params.n_threads = std::stoi(argv[++i]);
+            std::lock_guard<std::mutex> lock(mutex);
+            task = fn;
+            n_pending.store(nth - 1, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            cv.notify_all();
         }
-        else if (arg == "-p" || arg == "--prompt")
+        fn(0, nth);
+        while (n_pending.load(std::memory_order_acquire) > 0)
         {
-            params.prompt = argv[++i];
+            std::this_thread::yield();
         }
-        else if (arg == "--port")
+    }
+
+    void worker(int ith)
+    {
+        int64_t seen = 0;
+        while (true)
         {
-            params.port = std::stoi(argv[++i]);
+            // spin first, new work usually follows soon after the last
+            const auto t_start = std::chrono::steady_clock::now();
+            while (generation.load(std::memory_order_acquire) == seen)
+            {
+                if (std::chrono::steady_clock::now() - t_start > std::chrono::microseconds(spin_us))
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return stop || generation.load(std::memory_order_acquire) != seen; });
+                    if (stop)
+                    {
+                        return;
+                    }
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            seen = generation.load(std::memory_order_acquire);
+            task(ith, n_threads());
+            n_pending.fetch_sub(1, std::memory_order_release);
         }
-        else if (arg == "-m" || arg == "--model")
+    }
+
+#if defined(__linux__)
+    static void pin(pthread_t thread, size_t i)
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i % std::thread::hardware_concurrency(), &cpuset);
+        pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset);
+    }
+#endif
+
+    ~bert_threadpool()
+    {
         {
-            params.model = argv[++i];
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
         }
-        else if (arg == "-h" || arg == "--help")
+        cv.notify_all();
+        for (auto & worker : workers)
         {
-            bert_print_usage(argv, params);
-            exit(0);
+            worker.join();
         }
-        else
-        {
-            fprintf(stderr, "error: unknown argument: %s\n", arg.c_str());
-            bert_print_usage(argv, params);
-            exit(0);
+    }
+};
+
+// Encoder graph built for one batch shape, reused by every eval of that shape
+struct bert_graph
+{
+    bert_batch_mode mode;
+    int32_t N;          // token rows per input when padded, total token rows when packed
+    int32_t n_batch;
+    bool fused_attn;
+
+    bert_buffer buf;
+    std::vector<uint8_t> work;
+    struct ggml_context * ctx = nullptr;
+    struct ggml_cgraph gf = {};
+
+    // inputs, written before every eval
+    struct ggml_tensor * token_layer = nullptr;
+    struct ggml_tensor * positions = nullptr;
+    struct ggml_tensor * lengths = nullptr;
+    struct ggml_tensor * starts = nullptr;  // segments of fused attention
+    struct ggml_tensor * pooling = nullptr;
+
+    struct ggml_tensor * output = nullptr;
+
+    int64_t last_used = 0;
+
+    ~bert_graph() {
+        if (ctx) {
+            ggml_free(ctx);
         }
     }
+};
 
-    return true;
-}
+// Everything an eval writes to: compute graphs, stats and worker threads.
+// A state is used by one thread at a time, any number of states can share one context.
+struct bert_state
+{
+    bert_ctx * ctx;
 
-//
-// Tokenizing
-//
+    bert_batch_stats batch_stats;
 
-static size_t utf8_len(char src)
-{
-    const size_t lookup[] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 4};
-    uint8_t highbits = static_cast<uint8_t>(src) >> 4;
-    return lookup[highbits];
-}
+    std::vector<std::unique_ptr<bert_graph>> graphs;
+    int64_t graph_clock = 0;
+    bert_graph_cache_stats graph_stats;
+
+    std::unique_ptr<bert_threadpool> threadpool;
+};
 
-std::string stripAccents(const std::string &inputString)
+// Bounded cache of normalized word -> WordPiece ids, shared by all threads tokenizing with a context.
+// Words are sharded by hash, every shard has its own lock. When a shard is full, the words that weren't
+// used since the last sweep are evicted (second chance).
+struct bert_word_cache
 {
-    std::string resultString;
-    std::map<std::string, char> accentMap = {{"À", 'A'},{"Á", 'A'},
-        {"Â", 'A'},{"Ã", 'A'},{"Ä", 'A'},{"Å", 'A'},{"à", 'a'},{"á", 'a'},
-        {"â", 'a'},{"ã", 'a'},{"ä", 'a'},{"å", 'a'},{"È", 'E'},{"É", 'E'},
-        {"Ê", 'E'},{"Ë", 'E'},{"è", 'e'},{"é", 'e'},{"ê", 'e'},{"ë", 'e'},
-        {"Ì", 'I'},{"Í", 'I'},{"Î", 'I'},{"Ï", 'I'},{"ì", 'i'},{"í", 'i'},
-        {"î", 'i'},{"ï", 'i'},{"Ò", 'O'},{"Ó", 'O'},{"Ô", 'O'},{"Õ", 'O'},
-        {"Ö", 'O'},{"ò", 'o'},{"ó", 'o'},{"ô", 'o'},{"õ", 'o'},{"ö", 'o'},
-        {"Ù", 'U'},{"Ú", 'U'},{"Û", 'U'},{"Ü", 'U'},{"ù", 'u'},{"ú", 'u'},
-        {"û", 'u'},{"ü", 'u'},{"Ý", 'Y'},{"ý", 'y'},{"Ç", 'C'},{"ç", 'c'},
-        {"Ñ", 'N'},{"ñ", 'n'},
+    static const int n_shards = 16;
+
+    struct entry
+    {
+        std::string word;
+        std::vector<bert_vocab_id> ids;
+        bool used;
     };
 
-    for (size_t i = 0; i < inputString.length();)
+    struct shard
     {
-        int len = utf8_len(inputString[i]);
-        std::string curChar = inputString.substr(i, len);
-        auto iter = accentMap.find(curChar);
-        if (iter != accentMap.end())
-        {
-            resultString += iter->second;
-        }
-        else
-        {
-            resultString += curChar;
-        }
-        i += len;
-    }
+        std::mutex mutex;
+        std::unordered_map<uint64_t, entry> words;
+        size_t mem_size = 0;
+    };
 
-    return resultString;
-}
+    shard shards[n_shards];
+    size_t max_shard_mem;
 
-std::string bert_normalize_prompt(const std::string &text)
-{
-    // TODO: handle chinese characters? https://github.com/huggingface/tokenizers/blob/ef5f50605ddf9f8caef1598c0e4853862b9707a7/tokenizers/src/normalizers/bert.rs#L98
-    std::string text2 = stripAccents(text);
-    for (size_t i = 0; i < text2.size(); i += utf8_len(text2[i]))
-    {
-        char c = text2[i];
-        if (c >= 'A' && c <= 'Z')
-            text2[i] = c - 'A' + 'a';
-    }
-    return text2;
-}
-void bert_tokenize(
-    struct bert_ctx * ctx,
-    const char * text,
-    bert_vocab_id * tokens,
-    int32_t * n_tokens,
-    int32_t n_max_tokens)
-{
-    int cls_tok_id = 101;
-    int sep_tok_id = 102;
-    const bert_vocab &vocab = ctx->vocab;
+    std::atomic<int64_t> n_hits{0};
+    std::atomic<int64_t> n_misses{0};
 
-    std::string str = text;
+    explicit bert_word_cache(size_t max_mem_size) : max_shard_mem(max_mem_size / n_shards) {}
 
-    std::vector<std::string> words;
-    // first split the text into words
+    static uint64_t hash(std::string_view word)
     {
-        str = bert_normalize_prompt(str);
-
-        std::string pat = R"([[:punct:]]|[[:alpha:]]+|[[:digit:]]+)";
+        return bert_hash(word);
+    }
 
-        std::regex re(pat);
-        std::smatch m;
+    static size_t entry_mem(const entry & e)
+    {
+        return sizeof(uint64_t) + sizeof(entry) + e.word.size() + e.ids.size() * sizeof(bert_vocab_id) + 32; // 32 for the map node
+    }
 
-        while (std::regex_search(str, m, re))
+    // Copies up to n_max ids of the word to ids, returns the number of ids of the word or -1 if it isn't cached
+    int lookup(std::string_view word, uint64_t h, bert_vocab_id * ids, int n_max)
+    {
+        shard & sh = shards[h % n_shards];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        auto it = sh.words.find(h);
+        if (it == sh.words.end() || it->second.word != word)
         {
-            for (std::string x : m)
-            {
-                words.push_back(x);
-            }
-            str = m.suffix();
+            n_misses.fetch_add(1, std::memory_order_relaxed);
+            return -1;
         }
+        n_hits.fetch_add(1, std::memory_order_relaxed);
+        entry & e = it->second;
+        e.used = true;
+        const int n = e.ids.size();
+        std::copy(e.ids.begin(), e.ids.begin() + std::min(n, n_max), ids);
+        return n;
     }
 
-    int32_t t = 0;
-    tokens[t++] = cls_tok_id;
-
-    // find the longest tokens that form the words:
-    for (const auto &word : words)
+    void insert(std::string_view word, uint64_t h, const bert_vocab_id * ids, int n)
     {
-        if (word.size() == 0)
-            continue;
-
-        int i = 0;
-        int n = word.size();
-        auto *token_map = &vocab.token_to_id;
-    loop:
-        while (i < n)
+        shard & sh = shards[h % n_shards];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        entry e = {std::string(word), std::vector<bert_vocab_id>(ids, ids + n), false};
+        const size_t mem = entry_mem(e);
+        if (mem > max_shard_mem)
         {
-            if (t >= n_max_tokens - 1)
-                break;
-            int j = n;
-            while (j > i)
+            return;
+        }
+        if (sh.mem_size + mem > max_shard_mem)
+        {
+            for (auto it = sh.words.begin(); it != sh.words.end();)
             {
-                auto it = token_map->find(word.substr(i, j - i));
-                if (it != token_map->end())
+                if (it->second.used)
+                {
+                    it->second.used = false;
+                    ++it;
+                }
+                else
                 {
-                    tokens[t++] = it->second;
-                    i = j;
-                    token_map = &vocab.subword_token_to_id;
-                    goto loop;
+                    sh.mem_size -= entry_mem(it->second);
+                    it = sh.words.erase(it);
                 }
-                --j;
             }
-            if (j == i)
+            if (sh.mem_size + mem > max_shard_mem)
             {
-                fprintf(stderr, "%s: unknown token '%s'\n", __func__, word.substr(i, 1).data());
-                token_map = &vocab.subword_token_to_id;
-                ++i;
+                return;
             }
         }
+        // words with colliding hashes are not cached
+        auto res = sh.words.emplace(h, std::move(e));
+        if (res.second)
+        {
+            sh.mem_size += mem;
+        }
     }
-    tokens[t++] = sep_tok_id;
-    *n_tokens = t;
-}
 
-//
-// Loading and setup
-//
+    bert_word_cache_stats stats()
+    {
+        bert_word_cache_stats stats = {};
+        stats.n_hits = n_hits.load(std::memory_order_relaxed);
+        stats.n_misses = n_misses.load(std::memory_order_relaxed);
+        stats.max_mem_size = max_shard_mem * n_shards;
+        for (auto & sh : shards)
+        {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            stats.n_words += sh.words.size();
+            stats.mem_size += sh.mem_size;
+        }
+        return stats;
+    }
+};
 
-struct bert_ctx * bert_load_from_file(const char *fname)
+// Final embeddings of token sequences, keyed by a hash of the tokens so that texts that only differ
+// in case or accents share an entry. Sharded like the word cache, each shard evicts its least
+// recently used entries to stay under its share of the memory limit.
+struct bert_embedding_cache
 {
-    printf("%s: loading model from '%s' - please wait ...\n", __func__, fname);
+    static const int n_shards = 16;
+
+    struct entry
+    {
+        uint64_t hash;
+        std::vector<bert_vocab_id> tokens;
+        std::vector<float> embedding;
+    };
+
+    struct shard
+    {
+        std::mutex mutex;
+        std::list<entry> lru; // most recently used first
+        std::unordered_map<uint64_t, std::list<entry>::iterator> entries;
+        size_t mem_size = 0;
+    };
+
+    shard shards[n_shards];
+    size_t max_shard_mem;
+
+    std::atomic<int64_t> n_hits{0};
+    std::atomic<int64_t> n_misses{0};
+    std::atomic<int64_t> n_evictions{0};
+
+    explicit bert_embedding_cache(size_t max_mem_size) : max_shard_mem(max_mem_size / n_shards) {}
+
+    static uint64_t hash(const bert_vocab_id * tokens, int32_t n_tokens)
+    {
+        return bert_hash(std::string_view((const char *) tokens, n_tokens * sizeof(bert_vocab_id)));
+    }
+
+    static size_t entry_mem(const entry & e)
+    {
+        return sizeof(entry) + e.tokens.size() * sizeof(bert_vocab_id) + e.embedding.size() * sizeof(float) + 64; // 64 for the list and map nodes
+    }
+
+    // Copies the embedding of the tokens to embedding, returns false if they aren't cached
+    bool lookup(const bert_vocab_id * tokens, int32_t n_tokens, uint64_t h, float * embedding)
+    {
+        shard & sh = shards[h % n_shards];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        auto it = sh.entries.find(h);
+        if (it == sh.entries.end() || !std::equal(tokens, tokens + n_tokens, it->second->tokens.begin(), it->second->tokens.end()))
+        {
+            n_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        n_hits.fetch_add(1, std::memory_order_relaxed);
+        sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+        std::copy(it->second->embedding.begin(), it->second->embedding.end(), embedding);
+        return true;
+    }
+
+    void insert(const bert_vocab_id * tokens, int32_t n_tokens, uint64_t h, const float * embedding, int32_t n_embd)
+    {
+        shard & sh = shards[h % n_shards];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        if (sh.entries.count(h))
+        {
+            // already cached, or a different sequence with the same hash which isn't cached
+            return;
+        }
+        entry e = {h, std::vector<bert_vocab_id>(tokens, tokens + n_tokens), std::vector<float>(embedding, embedding + n_embd)};
+        const size_t mem = entry_mem(e);
+        if (mem > max_shard_mem)
+        {
+            return;
+        }
+        while (sh.mem_size + mem > max_shard_mem)
+        {
+            const entry & last = sh.lru.back();
+            sh.mem_size -= entry_mem(last);
+            sh.entries.erase(last.hash);
+            sh.lru.pop_back();
+            n_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        sh.lru.push_front(std::move(e));
+        sh.entries.emplace(h, sh.lru.begin());
+        sh.mem_size += mem;
+    }
+
+    bert_embedding_cache_stats stats()
+    {
+        bert_embedding_cache_stats stats = {};
+        stats.n_hits = n_hits.load(std::memory_order_relaxed);
+        stats.n_misses = n_misses.load(std::memory_order_relaxed);
+        stats.n_evictions = n_evictions.load(std::memory_order_relaxed);
+        stats.max_mem_size = max_shard_mem * n_shards;
+        for (auto & sh : shards)
+        {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            stats.n_entries += sh.entries.size();
+            stats.mem_size += sh.mem_size;
+        }
+        return stats;
+    }
+};
+
+// Embeddings kept in a file that several processes can share, keyed by the hash of the model file
+// and the hash of the tokens. The file is a header and records appended one after the other, it gets
+// its full capacity when it is created and is mapped whole, so it never has to be remapped.
+// Records are immutable once the size in the header covers them: reads don't lock, appends hold
+// an exclusive flock on the file so there is a single writer across processes.
+struct bert_embedding_store
+{
+    static const uint32_t magic = 0x67676265; // "ggbe"
+    static const uint32_t version = 1;
+
+    struct header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;  // size of the file
+        uint64_t size;      // bytes of complete records after the header
+        uint8_t padding[40];
+    };
+
+    // followed by n_embd floats, padded to 8 bytes
+    struct record
+    {
+        uint64_t model_hash;
+        uint64_t hash;      // bert_embedding_cache::hash of the tokens
+        uint64_t check;     // hash of the tokens with another offset basis, rejects collisions of hash
+        uint32_t n_tokens;
+        uint32_t n_embd;
+    };
+
+    int fd = -1;
+    uint8_t * addr = nullptr;
+    size_t capacity = 0;
+
+    uint64_t model_hash = 0;
+    int32_t n_embd = 0;
+
+    // offsets of the records of this model, extended with what other processes appended on misses
+    std::mutex mutex;
+    std::unordered_map<uint64_t, uint64_t> index;
+    uint64_t n_scanned = 0;
+
+    // one appending thread per process, the flock keeps out other processes
+    std::mutex append_mutex;
+
+    std::atomic<int64_t> n_hits{0};
+    std::atomic<int64_t> n_misses{0};
+    std::atomic<int64_t> n_appends{0};
+
+    static uint64_t check_hash(const bert_vocab_id * tokens, int32_t n_tokens)
+    {
+        return bert_hash(std::string_view((const char *) tokens, n_tokens * sizeof(bert_vocab_id)), 0x84222325cbf29ce4ull);
+    }
+
+    static uint64_t record_size(uint32_t n_embd)
+    {
+        return sizeof(record) + (uint64_t(n_embd) * sizeof(float) + 7) / 8 * 8;
+    }
+
+    header & head()
+    {
+        return *(header *) addr;
+    }
+
+#ifdef BERT_USE_MMAP
+    // Opens the store at path or creates it with max_size bytes
+    bool open(const char * path, size_t max_size)
+    {
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd == -1)
+        {
+            return false;
+        }
+
+        // creating and checking the header happens under the lock
+        flock(fd, LOCK_EX);
+        bool ok = true;
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ok = false;
+        }
+        else if (st.st_size == 0)
+        {
+            capacity = std::max(max_size, sizeof(header));
+            header h = {magic, version, capacity, 0, {}};
+            ok = ftruncate(fd, capacity) == 0 && pwrite(fd, &h, sizeof(h), 0) == (ssize_t) sizeof(h);
+        }
+        else
+        {
+            header h;
+            ok = pread(fd, &h, sizeof(h), 0) == (ssize_t) sizeof(h) &&
+                 h.magic == magic && h.version == version && h.capacity == (uint64_t) st.st_size;
+            capacity = h.capacity;
+        }
+        if (ok)
+        {
+            void * a = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ok = a != MAP_FAILED;
+            addr = ok ? (uint8_t *) a : nullptr;
+        }
+        flock(fd, LOCK_UN);
+
+        if (!ok)
+        {
+            close(fd);
+            fd = -1;
+        }
+        return ok;
+    }
+
+    void lock_file()
+    {
+        flock(fd, LOCK_EX);
+    }
+
+    void unlock_file()
+    {
+        flock(fd, LOCK_UN);
+    }
+
+    ~bert_embedding_store()
+    {
+        if (addr)
+        {
+            munmap(addr, capacity);
+        }
+        if (fd != -1)
+        {
+            close(fd);
+        }
+    }
+#else
+    bool open(const char *, size_t)
+    {
+        return false;
+    }
+
+    void lock_file() {}
+    void unlock_file() {}
+#endif
+
+    // Indexes the records appended since the last call, mutex must be held
+    void refresh()
+    {
+        const uint64_t size = __atomic_load_n(&head().size, __ATOMIC_ACQUIRE);
+        while (n_scanned + sizeof(record) <= size)
+        {
+            const record * r = (const record *) (addr + sizeof(header) + n_scanned);
+            const uint64_t r_size = record_size(r->n_embd);
+            if (n_scanned + r_size > size)
+            {
+                break;
+            }
+            if (r->model_hash == model_hash && r->n_embd == (uint32_t) n_embd)
+            {
+                index.emplace(r->hash, n_scanned);
+            }
+            n_scanned += r_size;
+        }
+    }
+
+    // Copies the stored embedding of the tokens to embedding, returns false if there is none
+    bool lookup(const bert_vocab_id * tokens, int32_t n_tokens, uint64_t h, float * embedding)
+    {
+        uint64_t offset;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = index.find(h);
+            if (it == index.end())
+            {
+                refresh();
+                it = index.find(h);
+            }
+            if (it == index.end())
+            {
+                n_misses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            offset = it->second;
+        }
+
+        const record * r = (const record *) (addr + sizeof(header) + offset);
+        if (r->n_tokens != (uint32_t) n_tokens || r->check != check_hash(tokens, n_tokens))
+        {
+            n_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const float * data = (const float *) (r + 1);
+        std::copy(data, data + n_embd, embedding);
+        n_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Appends the embeddings that aren't stored yet, until the file is full
+    void append(
+        int32_t n_records,
+        bert_vocab_id * const * tokens,
+        const int32_t * n_tokens,
+        const uint64_t * hashes,
+        float * const * embeddings)
+    {
+        std::lock_guard<std::mutex> append_lock(append_mutex);
+        lock_file();
+
+        // other processes may have stored some of them in the meantime
+        std::vector<int32_t> missing;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            refresh();
+            for (int32_t i = 0; i < n_records; i++)
+            {
+                if (index.count(hashes[i]) == 0)
+                {
+                    missing.push_back(i);
+                }
+            }
+        }
+
+        uint64_t size = __atomic_load_n(&head().size, __ATOMIC_ACQUIRE);
+        const uint64_t r_size = record_size(n_embd);
+        for (int32_t i : missing)
+        {
+            if (sizeof(header) + size + r_size > capacity)
+            {
+                break;
+            }
+            record * r = (record *) (addr + sizeof(header) + size);
+            r->model_hash = model_hash;
+            r->hash = hashes[i];
+            r->check = check_hash(tokens[i], n_tokens[i]);
+            r->n_tokens = n_tokens[i];
+            r->n_embd = n_embd;
+            memcpy(r + 1, embeddings[i], n_embd * sizeof(float));
+            size += r_size;
+            n_appends.fetch_add(1, std::memory_order_relaxed);
+        }
+        // publish the records
+        __atomic_store_n(&head().size, size, __ATOMIC_RELEASE);
+
+        unlock_file();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        refresh();
+    }
+
+    bert_embedding_store_stats stats()
+    {
+        bert_embedding_store_stats stats = {};
+        stats.n_hits = n_hits.load(std::memory_order_relaxed);
+        stats.n_misses = n_misses.load(std::memory_order_relaxed);
+        stats.n_appends = n_appends.load(std::memory_order_relaxed);
+        stats.size = sizeof(header) + __atomic_load_n(&head().size, __ATOMIC_ACQUIRE);
+        stats.max_size = capacity;
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.n_records = index.size();
+        return stats;
+    }
+};
+
+// Hash of a buffer, 8 bytes at a time
+static uint64_t bert_hash_bytes(const void * data, size_t size, uint64_t h = 0xcbf29ce484222325ull)
+{
+    const uint8_t * p = (const uint8_t *) data;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 32;
+    }
+    uint64_t w = 0;
+    memcpy(&w, p + i, size - i);
+    h = (h ^ w) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 32;
+    return (h ^ size) * 0x100000001b3ull;
+}
+
+// Model weights, vocab and settings, read-only once loaded.
+// The word and embedding caches and the embedding store are the exception, they synchronize themselves.
+struct bert_ctx
+{
+    bert_model model;
+    bert_vocab vocab;
+
+    size_t mem_per_token;
+    int64_t mem_per_input;
+
+    int32_t max_batch_tokens;
+    bert_batch_mode batch_mode = BERT_BATCH_PADDED;
+    bool fused_attn = true;
+
+    // idle tokenization workers sleep right away by default, spinning would take cores from ggml's threads
+    int32_t threadpool_spin_us = 0;
+    bool threadpool_pin = false;
+
+    std::unique_ptr<bert_word_cache> word_cache;
+    std::unique_ptr<bert_embedding_cache> embedding_cache;
+    std::unique_ptr<bert_embedding_store> embedding_store;
+
+    // hash of the hparams, vocab and weights as loaded, the embedding store is keyed by it.
+    // 0 until the first store is set, hashing reads every weight
+    uint64_t model_hash = 0;
+
+    // state used by the calls that take the context
+    std::unique_ptr<bert_state> state;
+};
+
+// Returns the worker pool of the state, (re)starting it if n_threads or the pool params of the context changed
+static bert_threadpool & bert_get_threadpool(bert_state * state, int32_t n_threads)
+{
+    const bert_ctx * ctx = state->ctx;
+    n_threads = std::max(n_threads, 1);
+    if (!state->threadpool || state->threadpool->n_threads() != n_threads ||
+        state->threadpool->spin_us != ctx->threadpool_spin_us || state->threadpool->pin_threads != ctx->threadpool_pin)
+    {
+        state->threadpool.reset();
+        state->threadpool = std::make_unique<bert_threadpool>();
+        state->threadpool->start(n_threads, ctx->threadpool_spin_us, ctx->threadpool_pin);
+    }
+    return *state->threadpool;
+}
+
+struct bert_state * bert_state_new(bert_ctx * ctx)
+{
+    bert_state * state = new bert_state;
+    state->ctx = ctx;
+    state->batch_stats = {};
+    state->graph_stats = {};
+    return state;
+}
+
+void bert_state_free(bert_state * state)
+{
+    delete state;
+}
+
+int32_t bert_n_embd(bert_ctx * ctx)
+{
+    return ctx->model.hparams.n_embd;
+}
+
+int32_t bert_n_vocab(bert_ctx * ctx)
+{
+    return ctx->vocab.size();
+}
+
+int32_t bert_n_max_tokens(bert_ctx * ctx)
+{
+    return ctx->model.hparams.n_max_tokens;
+}
+
+void bert_set_max_batch_tokens(bert_ctx * ctx, int32_t n_max_batch_tokens)
+{
+    ctx->max_batch_tokens = std::max(n_max_batch_tokens, bert_n_max_tokens(ctx));
+}
+
+void bert_set_batch_mode(bert_ctx * ctx, enum bert_batch_mode mode)
+{
+    ctx->batch_mode = mode;
+}
+
+void bert_set_fused_attention(bert_ctx * ctx, bool fused)
+{
+    ctx->fused_attn = fused;
+}
+
+void bert_set_threadpool_params(bert_ctx * ctx, int32_t spin_us, bool pin_threads)
+{
+    // the pool of every state is restarted with the new params on its next use
+    ctx->threadpool_spin_us = spin_us;
+    ctx->threadpool_pin = pin_threads;
+}
+
+void bert_set_word_cache_size(bert_ctx * ctx, size_t max_mem_size)
+{
+    ctx->word_cache.reset();
+    if (max_mem_size > 0)
+    {
+        ctx->word_cache = std::make_unique<bert_word_cache>(max_mem_size);
+    }
+}
+
+struct bert_word_cache_stats bert_get_word_cache_stats(bert_ctx * ctx)
+{
+    if (!ctx->word_cache)
+    {
+        return {};
+    }
+    return ctx->word_cache->stats();
+}
+
+void bert_set_embedding_cache_size(bert_ctx * ctx, size_t max_mem_size)
+{
+    ctx->embedding_cache.reset();
+    if (max_mem_size > 0)
+    {
+        ctx->embedding_cache = std::make_unique<bert_embedding_cache>(max_mem_size);
+    }
+}
+
+struct bert_embedding_cache_stats bert_get_embedding_cache_stats(bert_ctx * ctx)
+{
+    if (!ctx->embedding_cache)
+    {
+        return {};
+    }
+    return ctx->embedding_cache->stats();
+}
+
+// Hashes what was loaded rather than the file, which a deploy may replace after the load
+static uint64_t bert_model_hash(const bert_ctx * ctx)
+{
+    uint64_t h = bert_hash_bytes(&ctx->model.hparams, sizeof(ctx->model.hparams));
+    h = bert_hash_bytes(ctx->vocab.text.data(), ctx->vocab.text.size(), h);
+    for (const auto & kv : ctx->model.tensors)
+    {
+        h = bert_hash_bytes(kv.first.data(), kv.first.size(), h);
+        h = bert_hash_bytes(kv.second->data, ggml_nbytes(kv.second), h);
+    }
+    return h;
+}
+
+bool bert_set_embedding_store(bert_ctx * ctx, const char * path, size_t max_size)
+{
+    ctx->embedding_store.reset();
+    if (!path)
+    {
+        return true;
+    }
+
+    if (ctx->model_hash == 0)
+    {
+        ctx->model_hash = bert_model_hash(ctx);
+    }
+
+    auto store = std::make_unique<bert_embedding_store>();
+    store->n_embd = ctx->model.hparams.n_embd;
+    store->model_hash = ctx->model_hash;
+    if (!store->open(path, max_size))
+    {
+        fprintf(stderr, "%s: failed to open embedding store '%s'\n", __func__, path);
+        return false;
+    }
+    ctx->embedding_store = std::move(store);
+    return true;
+}
+
+struct bert_embedding_store_stats bert_get_embedding_store_stats(bert_ctx * ctx)
+{
+    if (!ctx->embedding_store)
+    {
+        return {};
+    }
+    return ctx->embedding_store->stats();
+}
+
+struct bert_batch_stats bert_state_get_batch_stats(bert_state * state)
+{
+    return state->batch_stats;
+}
+
+struct bert_batch_stats bert_get_batch_stats(bert_ctx * ctx)
+{
+    return bert_state_get_batch_stats(ctx->state.get());
+}
+
+struct bert_graph_cache_stats bert_state_get_graph_cache_stats(bert_state * state)
+{
+    bert_graph_cache_stats stats = state->graph_stats;
+    stats.n_graphs = state->graphs.size();
+    stats.mem_size = 0;
+    for (const auto & graph : state->graphs)
+    {
+        stats.mem_size += graph->buf.size;
+    }
+    return stats;
+}
+
+struct bert_graph_cache_stats bert_get_graph_cache_stats(bert_ctx * ctx)
+{
+    return bert_state_get_graph_cache_stats(ctx->state.get());
+}
+
+const char* bert_vocab_id_to_token(bert_ctx * ctx, bert_vocab_id id) {
+    const bert_vocab & vocab = ctx->vocab;
+    if (id >= 0 && id < vocab.size())
+    {
+        return vocab.token(id).data();
+    }
+    return "[UNK TOKEN from bert_vocab]";
+}
+
+//
+// Cli interface
+//
+
+void bert_print_usage(char **argv, const bert_params &params)
+{
+    fprintf(stderr, "usage: %s [options]\n", argv[0]);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "options:\n");
+    fprintf(stderr, "  -h, --help            show this help message and exit\n");
+    fprintf(stderr, "  -s SEED, --seed SEED  RNG seed (default: -1)\n");
+    fprintf(stderr, "  -t N, --threads N     number of threads to use during computation (default: %d)\n", params.n_threads);
+    fprintf(stderr, "  -p PROMPT, --prompt PROMPT\n");
+    fprintf(stderr, "                        prompt to start generation with (default: random)\n");
+    fprintf(stderr, "  --port p     port to bind in server mode (default: %d)\n", params.port);
+    fprintf(stderr, "  --workers N  number of eval workers in server mode (default: %d)\n", params.n_workers);
+    fprintf(stderr, "  --batch-size N        max texts per batch in server mode (default: %d)\n", params.n_batch_size);
+    fprintf(stderr, "  --batch-wait-us N     max microseconds a request waits for its batch to fill in server mode (default: %d)\n", params.batch_wait_us);
+    fprintf(stderr, "  --max-queue N         max texts waiting per priority in server mode, more are refused (default: %d)\n", params.n_max_queue);
+    fprintf(stderr, "  --metrics-port p      local port of the metrics endpoint in server mode, 0 disables it (default: %d)\n", params.metrics_port);
+    fprintf(stderr, "  --embedding-cache-mb N  size of the embedding cache in server mode (default: %d)\n", params.embedding_cache_mb);
+    fprintf(stderr, "  -m FNAME, --model FNAME\n");
+    fprintf(stderr, "                        model path (default: %s)\n", params.model);
+    fprintf(stderr, "\n");
+}
+
+
+bool bert_params_parse(int argc, char **argv, bert_params &params)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-t" || arg == "--threads")
+        {
+            params.n_threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "-p" || arg == "--prompt")
+        {
+            params.prompt = argv[++i];
+        }
+        else if (arg == "--port")
+        {
+            params.port = std::stoi(argv[++i]);
+        }
+        else if (arg == "--workers")
+        {
+            params.n_workers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--batch-size")
+        {
+            params.n_batch_size = std::stoi(argv[++i]);
+        }
+        else if (arg == "--batch-wait-us")
+        {
+            params.batch_wait_us = std::stoi(argv[++i]);
+        }
+        else if (arg == "--max-queue")
+        {
+            params.n_max_queue = std::stoi(argv[++i]);
+        }
+        else if (arg == "--metrics-port")
+        {
+            params.metrics_port = std::stoi(argv[++i]);
+        }
+        else if (arg == "--embedding-cache-mb")
+        {
+            params.embedding_cache_mb = std::stoi(argv[++i]);
+        }
+        else if (arg == "-m" || arg == "--model")
+        {
+            params.model = argv[++i];
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            bert_print_usage(argv, params);
+            exit(0);
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown argument: %s\n", arg.c_str());
+            bert_print_usage(argv, params);
+            exit(0);
+        }
+    }
+
+    return true;
+}
+
+//
+// Tokenizing
+//
+
+// Appends the UTF-8 encoding of cp to out, returns its length
+static int bert_utf8_encode(uint32_t cp, char * out)
+{
+    if (cp < 0x80)
+    {
+        out[0] = cp;
+        return 1;
+    }
+    if (cp < 0x800)
+    {
+        out[0] = 0xC0 | (cp >> 6);
+        out[1] = 0x80 | (cp & 0x3F);
+        return 2;
+    }
+    if (cp < 0x10000)
+    {
+        out[0] = 0xE0 | (cp >> 12);
+        out[1] = 0x80 | ((cp >> 6) & 0x3F);
+        out[2] = 0x80 | (cp & 0x3F);
+        return 3;
+    }
+    out[0] = 0xF0 | (cp >> 18);
+    out[1] = 0x80 | ((cp >> 12) & 0x3F);
+    out[2] = 0x80 | ((cp >> 6) & 0x3F);
+    out[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
+
+// Decodes the code point starting at text[0], returns its length in bytes or 0 if it isn't valid UTF-8
+static int bert_utf8_decode(const char * text, size_t n, uint32_t & cp)
+{
+    const uint8_t c = text[0];
+    int len = c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF5 ? 4 : 0;
+    if (len == 0 || size_t(len) > n)
+    {
+        return 0;
+    }
+    cp = c & (0x7F >> len);
+    for (int i = 1; i < len; i++)
+    {
+        const uint8_t cc = text[i];
+        if ((cc & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    return len;
+}
+
+// Normalization of non-ASCII code points with the tables of unicode_data.h: lowercasing, removing accents
+// (NFD without combining marks) and removing control characters. Two byte UTF-8 (Latin, Greek, Cyrillic,
+// Hebrew, Arabic...) is looked up in a dense table, the rest by binary search.
+struct bert_unicode_normalizer
+{
+    static const uint32_t n_dense = 0x800;
+    uint16_t dense[n_dense]; // normalized code point, 0 if removed
+
+    bert_unicode_normalizer()
+    {
+        for (uint32_t cp = 0; cp < n_dense; cp++)
+        {
+            dense[cp] = cp;
+        }
+        for (const auto & r : bert_unicode_removed)
+        {
+            for (uint32_t cp = r[0]; cp <= r[1] && cp < n_dense; cp++)
+            {
+                dense[cp] = 0;
+            }
+        }
+        for (const auto & m : bert_unicode_single)
+        {
+            if (m[0] < n_dense)
+            {
+                dense[m[0]] = m[1];
+            }
+        }
+    }
+
+    // Writes the normalized cp to out (up to 16 bytes), returns the number of bytes written
+    int normalize(uint32_t cp, char * out) const
+    {
+        if (cp < n_dense)
+        {
+            return dense[cp] ? bert_utf8_encode(dense[cp], out) : 0;
+        }
+
+        // hangul syllables decompose into their jamo
+        if (cp >= 0xAC00 && cp <= 0xD7A3)
+        {
+            const uint32_t s = cp - 0xAC00;
+            int len = bert_utf8_encode(0x1100 + s / 588, out);
+            len += bert_utf8_encode(0x1161 + (s % 588) / 28, out + len);
+            if (s % 28)
+            {
+                len += bert_utf8_encode(0x11A7 + s % 28, out + len);
+            }
+            return len;
+        }
+
+        auto removed = std::upper_bound(std::begin(bert_unicode_removed), std::end(bert_unicode_removed), cp,
+                                        [](uint32_t cp, const uint32_t (&r)[2]) { return cp < r[0]; });
+        if (removed != std::begin(bert_unicode_removed) && cp <= (*(removed - 1))[1])
+        {
+            return 0;
+        }
+
+        auto single = std::lower_bound(std::begin(bert_unicode_single), std::end(bert_unicode_single), cp,
+                                       [](const uint32_t (&m)[2], uint32_t cp) { return m[0] < cp; });
+        if (single != std::end(bert_unicode_single) && (*single)[0] == cp)
+        {
+            return bert_utf8_encode((*single)[1], out);
+        }
+
+        auto multi = std::lower_bound(std::begin(bert_unicode_multi), std::end(bert_unicode_multi), cp,
+                                      [](const bert_unicode_multi_entry & m, uint32_t cp) { return m.cp < cp; });
+        if (multi != std::end(bert_unicode_multi) && multi->cp == cp)
+        {
+            const int len = strlen(multi->utf8);
+            memcpy(out, multi->utf8, len);
+            return len;
+        }
+
+        return bert_utf8_encode(cp, out);
+    }
+};
+
+static const bert_unicode_normalizer bert_unicode;
+
+// Copies the ASCII prefix of src to dst, lowercased, returns its length
+static size_t bert_lower_ascii(const char * src, size_t n, char * dst)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i before_a = _mm_set1_epi8('A' - 1);
+    const __m128i after_z = _mm_set1_epi8('Z' + 1);
+    const __m128i to_lower = _mm_set1_epi8('a' - 'A');
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(v) != 0)
+        {
+            break;
+        }
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, before_a), _mm_cmplt_epi8(v, after_z));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_add_epi8(v, _mm_and_si128(upper, to_lower)));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        const char c = src[i];
+        if ((uint8_t) c >= 0x80)
+        {
+            break;
+        }
+        dst[i] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+    }
+    return i;
+}
+
+std::string bert_normalize_prompt(const std::string &text)
+{
+    const size_t n = text.size();
+    std::string out(n, '\0');
+    size_t o = 0;
+    for (size_t i = 0; i < n;)
+    {
+        // ASCII only needs lowercasing, out always has room for the rest of the text
+        const size_t n_ascii = bert_lower_ascii(text.data() + i, n - i, &out[o]);
+        i += n_ascii;
+        o += n_ascii;
+        if (i == n)
+        {
+            break;
+        }
+
+        char buf[16];
+        int len = 1;
+        uint32_t cp;
+        int n_out;
+        const int n_in = bert_utf8_decode(text.data() + i, n - i, cp);
+        if (n_in > 0)
+        {
+            n_out = bert_unicode.normalize(cp, buf);
+            len = n_in;
+        }
+        else
+        {
+            // invalid UTF-8, the pre-tokenizer drops it
+            buf[0] = text[i];
+            n_out = 1;
+        }
+        i += len;
+
+        if (o + n_out + (n - i) > out.size())
+        {
+            out.resize(std::max(o + n_out + (n - i), 2 * out.size()));
+        }
+        memcpy(&out[o], buf, n_out);
+        o += n_out;
+    }
+    out.resize(o);
+    return out;
+}
+
+// Pre-tokenizer character classes
+enum bert_char_class : uint8_t
+{
+    BERT_CHAR_SPACE = 0, // separates words and is dropped, also control characters and invalid UTF-8
+    BERT_CHAR_ALPHA,
+    BERT_CHAR_DIGIT,
+    BERT_CHAR_PUNCT,
+    BERT_CHAR_CJK,   // CJK ideographs, every one is a word like punctuation
+};
+
+struct bert_ascii_classes
+{
+    uint8_t cls[128];
+
+    bert_ascii_classes()
+    {
+        for (int c = 0; c < 128; c++)
+        {
+            cls[c] = isalpha(c) ? BERT_CHAR_ALPHA : isdigit(c) ? BERT_CHAR_DIGIT : ispunct(c) ? BERT_CHAR_PUNCT : BERT_CHAR_SPACE;
+        }
+    }
+};
+
+static const bert_ascii_classes bert_ascii;
+
+// Class of a non-ASCII code point. Punctuation follows the Unicode P* categories of the common blocks,
+// everything that isn't space, punctuation or CJK is part of words.
+static bert_char_class bert_unicode_class(uint32_t cp)
+{
+    static const uint32_t spaces[][2] = {
+        {0x0080, 0x00A0}, {0x00AD, 0x00AD}, {0x1680, 0x1680}, {0x2000, 0x200F}, {0x2028, 0x202F},
+        {0x205F, 0x206F}, {0x3000, 0x3000}, {0xFEFF, 0xFEFF},
+    };
+    static const uint32_t puncts[][2] = {
+        {0x00A1, 0x00A1}, {0x00A7, 0x00A7}, {0x00AB, 0x00AB}, {0x00B6, 0x00B7}, {0x00BB, 0x00BB},
+        {0x00BF, 0x00BF}, {0x037E, 0x037E}, {0x0387, 0x0387}, {0x055A, 0x055F}, {0x0589, 0x058A},
+        {0x05BE, 0x05BE}, {0x05C0, 0x05C0}, {0x05C3, 0x05C3}, {0x05C6, 0x05C6}, {0x05F3, 0x05F4},
+        {0x0609, 0x060A}, {0x060C, 0x060D}, {0x061B, 0x061F}, {0x066A, 0x066D}, {0x06D4, 0x06D4},
+        {0x0964, 0x0965}, {0x0970, 0x0970}, {0x0E4F, 0x0E4F}, {0x0E5A, 0x0E5B}, {0x2010, 0x2027},
+        {0x2030, 0x2043}, {0x2045, 0x2051}, {0x2053, 0x205E}, {0x207D, 0x207E}, {0x208D, 0x208E},
+        {0x2308, 0x230B}, {0x2329, 0x232A}, {0x2768, 0x2775}, {0x27C5, 0x27C6}, {0x27E6, 0x27EF},
+        {0x2983, 0x2998}, {0x29D8, 0x29DB}, {0x29FC, 0x29FD}, {0x2E00, 0x2E4F}, {0x3001, 0x3003},
+        {0x3008, 0x3011}, {0x3014, 0x301F}, {0x3030, 0x3030}, {0x303D, 0x303D}, {0x30A0, 0x30A0},
+        {0x30FB, 0x30FB}, {0xFE10, 0xFE19}, {0xFE30, 0xFE52}, {0xFE54, 0xFE61}, {0xFE63, 0xFE63},
+        {0xFE68, 0xFE68}, {0xFE6A, 0xFE6B}, {0xFF01, 0xFF03}, {0xFF05, 0xFF0A}, {0xFF0C, 0xFF0F},
+        {0xFF1A, 0xFF1B}, {0xFF1F, 0xFF20}, {0xFF3B, 0xFF3D}, {0xFF3F, 0xFF3F}, {0xFF5B, 0xFF5B},
+        {0xFF5D, 0xFF5D}, {0xFF5F, 0xFF65},
+    };
+    auto in = [cp](const auto & ranges)
+    {
+        for (const auto & r : ranges)
+        {
+            if (cp < r[0])
+            {
+                return false;
+            }
+            if (cp <= r[1])
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (in(spaces))
+    {
+        return BERT_CHAR_SPACE;
+    }
+    if (in(puncts))
+    {
+        return BERT_CHAR_PUNCT;
+    }
+    // the CJK ranges of the BERT tokenizer
+    static const uint32_t cjk[][2] = {
+        {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xF900, 0xFAFF}, {0x20000, 0x2A6DF}, {0x2A700, 0x2B73F},
+        {0x2B740, 0x2B81F}, {0x2B820, 0x2CEAF}, {0x2F800, 0x2FA1F},
+    };
+    if (in(cjk))
+    {
+        return BERT_CHAR_CJK;
+    }
+    return BERT_CHAR_ALPHA;
+}
+
+// Splits normalized text into words and calls on_word with each of them, in order.
+// Words are runs of letters, runs of digits or single punctuation or CJK characters.
+template <typename F>
+static void bert_pre_tokenize(std::string_view text, F && on_word)
+{
+    const size_t n = text.size();
+    size_t start = 0;
+    bert_char_class run = BERT_CHAR_SPACE;
+    for (size_t i = 0; i < n;)
+    {
+        bert_char_class cls;
+        int len = 1;
+        const uint8_t c = text[i];
+        if (c < 0x80)
+        {
+            cls = (bert_char_class) bert_ascii.cls[c];
+        }
+        else
+        {
+            uint32_t cp;
+            len = bert_utf8_decode(text.data() + i, n - i, cp);
+            cls = len > 0 ? bert_unicode_class(cp) : BERT_CHAR_SPACE;
+            len = std::max(len, 1);
+        }
+
+        if (run != BERT_CHAR_SPACE && (cls != run || cls == BERT_CHAR_PUNCT || cls == BERT_CHAR_CJK))
+        {
+            on_word(text.substr(start, i - start));
+            run = BERT_CHAR_SPACE;
+        }
+        if (run == BERT_CHAR_SPACE && cls != BERT_CHAR_SPACE)
+        {
+            start = i;
+            run = cls;
+        }
+        i += len;
+    }
+    if (run != BERT_CHAR_SPACE)
+    {
+        on_word(text.substr(start));
+    }
+}
+
+void bert_tokenize(
+    struct bert_ctx * ctx,
+    const char * text,
+    bert_vocab_id * tokens,
+    int32_t * n_tokens,
+    int32_t n_max_tokens)
+{
+    int cls_tok_id = 101;
+    int sep_tok_id = 102;
+    const bert_vocab &vocab = ctx->vocab;
+    bert_word_cache * cache = ctx->word_cache.get();
+
+    const std::string str = bert_normalize_prompt(text);
+
+    int32_t t = 0;
+    tokens[t++] = cls_tok_id;
+
+    // split the text into words and find the longest tokens that form the words:
+    bert_pre_tokenize(str, [&](std::string_view word)
+    {
+        uint64_t hash = 0;
+        if (cache)
+        {
+            hash = bert_word_cache::hash(word);
+            const int n_cached = cache->lookup(word, hash, tokens + t, std::max(n_max_tokens - 1 - t, 0));
+            if (n_cached >= 0)
+            {
+                t += std::min(n_cached, std::max(n_max_tokens - 1 - t, 0));
+                return;
+            }
+        }
+
+        const int32_t t_word = t;
+        int i = 0;
+        int n = word.size();
+        const bert_trie *trie = &vocab.token_trie;
+        while (i < n)
+        {
+            if (t >= n_max_tokens - 1)
+                break;
+            bert_vocab_id id;
+            int len = trie->longest_match(word.data() + i, n - i, id);
+            if (len > 0)
+            {
+                tokens[t++] = id;
+                i += len;
+            }
+            else
+            {
+                fprintf(stderr, "%s: unknown token '%.*s'\n", __func__, 1, word.data() + i);
+                ++i;
+            }
+            trie = &vocab.subword_token_trie;
+        }
+
+        // words cut short by n_max_tokens aren't complete
+        if (cache && i >= n)
+        {
+            cache->insert(word, hash, tokens + t_word, t - t_word);
+        }
+    });
+    tokens[t++] = sep_tok_id;
+    *n_tokens = t;
+}
+
+//
+// Loading and setup
+//
+
+// TODO: Max memory should be a param? Now just 1 GB
+static const int64_t BERT_MAX_COMPUTE_MEM = 1ll << 30;
+
+// Graphs are cached per shape, token rows are rounded up to a multiple of this
+static const int32_t BERT_GRAPH_ROWS_ALIGN = 16;
+static const size_t BERT_MAX_GRAPHS = 8;
+
+// Token rows of the graph that evaluates a batch with n_rows as the longest input
+// (padded) or as the total number of tokens (packed)
+static int32_t bert_graph_rows(const bert_ctx * ctx, bert_batch_mode mode, int32_t n_rows)
+{
+    int32_t rows = (n_rows + BERT_GRAPH_ROWS_ALIGN - 1) / BERT_GRAPH_ROWS_ALIGN * BERT_GRAPH_ROWS_ALIGN;
+    if (mode == BERT_BATCH_PADDED)
+    {
+        rows = std::min(rows, ctx->model.hparams.n_max_tokens);
+    }
+    return rows;
+}
+
+// Compute buffer size of the graph for n_batch inputs, see bert_graph_rows for n_rows
+static int64_t bert_graph_mem(const bert_ctx * ctx, bert_batch_mode mode, int32_t n_rows, int32_t n_batch)
+{
+    const auto &hparams = ctx->model.hparams;
+    const int64_t N = bert_graph_rows(ctx, mode, n_rows);
+    if (mode == BERT_BATCH_PACKED)
+    {
+        // fused attention doesn't keep the attention scores around
+        return 1.1 * ctx->mem_per_token * N;
+    }
+    if (ctx->fused_attn)
+    {
+        return 1.1 * ctx->mem_per_token * N * n_batch;
+    }
+    // the attention scores and their soft_max grow with N^2 per head and layer
+    int64_t mem_attention = 2 * int64_t(hparams.n_layer) * hparams.n_head * N * N * sizeof(float);
+    return 1.1 * n_batch * (ctx->mem_per_token * N + mem_attention); // add 10% to account for ggml object overhead
+}
+
+static void bert_build_graph(const bert_model & model, bert_graph & graph);
+
+// Model files
+//
+// Legacy files are the ggml magic, the hparams, the vocab and then one record (header and data)
+// per tensor. Versioned files start with their own magic and list all tensors in a directory
+// before the data, so the data can be mapped, read in any order and checked against the file size
+// up front:
+//
+//   uint32 magic, version, alignment, n_tensors
+//   int32  hparams (same as legacy)
+//   vocab  (same as legacy)
+//   n_tensors x { uint32 name length, name, int32 ftype, int32 n_dims, int32 ne[n_dims], uint64 offset, uint64 size }
+//   padding to alignment, then the tensor data, every tensor at an aligned offset from here
+//
+// q, k and v of each layer are stored fused, as "encoder.layer.N.attention.self.qkv.{weight,bias}".
+
+static const uint32_t BERT_FILE_MAGIC_LEGACY = 0x67676d6c; // "ggml"
+static const uint32_t BERT_FILE_MAGIC = 0x67676266;        // "ggbf"
+static const uint32_t BERT_FILE_VERSION = 1;
+
+// A tensor of the model file, offset is from the start of the file
+struct bert_file_tensor
+{
+    std::string name;
+    int32_t ftype;
+    int32_t n_dims;
+    int64_t ne[2];
+    size_t offset;
+    size_t size;
+};
+
+static ggml_type bert_ftype_to_type(int32_t ftype)
+{
+    switch (ftype)
+    {
+    case 0:
+        return GGML_TYPE_F32;
+    case 1:
+        return GGML_TYPE_F16;
+    case 2:
+        return GGML_TYPE_Q4_0;
+    case 3:
+        return GGML_TYPE_Q4_1;
+    default:
+        return GGML_TYPE_COUNT;
+    }
+}
+
+// Reads the tensor directory of a versioned file, fin is right after the vocab
+static bool bert_read_tensor_directory(std::ifstream & fin, uint32_t n_tensors, uint32_t alignment, std::vector<bert_file_tensor> & tensors)
+{
+    for (uint32_t i = 0; i < n_tensors; i++)
+    {
+        bert_file_tensor t;
+        uint32_t length;
+        fin.read((char *)&length, sizeof(length));
+        t.name.resize(length);
+        fin.read(&t.name[0], length);
+        fin.read((char *)&t.ftype, sizeof(t.ftype));
+        fin.read((char *)&t.n_dims, sizeof(t.n_dims));
+        if (!fin || t.n_dims < 1 || t.n_dims > 2)
+        {
+            return false;
+        }
+        t.ne[0] = t.ne[1] = 1;
+        for (int d = 0; d < t.n_dims; d++)
+        {
+            int32_t ne_cur;
+            fin.read((char *)&ne_cur, sizeof(ne_cur));
+            t.ne[d] = ne_cur;
+        }
+        uint64_t offset, size;
+        fin.read((char *)&offset, sizeof(offset));
+        fin.read((char *)&size, sizeof(size));
+        t.offset = offset;
+        t.size = size;
+        tensors.push_back(std::move(t));
+    }
+    if (!fin)
+    {
+        return false;
+    }
+
+    const size_t data_offset = ((size_t)fin.tellg() + alignment - 1) / alignment * alignment;
+    for (auto & t : tensors)
+    {
+        t.offset += data_offset;
+    }
+    return true;
+}
+
+// Collects the tensor records of a legacy file, fin is right after the vocab
+static bool bert_scan_tensor_records(std::ifstream & fin, std::vector<bert_file_tensor> & tensors)
+{
+    while (true)
+    {
+        bert_file_tensor t;
+        int32_t length;
+
+        fin.read(reinterpret_cast<char *>(&t.n_dims), sizeof(t.n_dims));
+        fin.read(reinterpret_cast<char *>(&length), sizeof(length));
+        fin.read(reinterpret_cast<char *>(&t.ftype), sizeof(t.ftype));
+
+        if (fin.eof())
+        {
+            return true;
+        }
+        if (t.n_dims < 1 || t.n_dims > 2 || length < 0)
+        {
+            return false;
+        }
+
+        int64_t nelements = 1;
+        t.ne[0] = t.ne[1] = 1;
+        for (int i = 0; i < t.n_dims; ++i)
+        {
+            int32_t ne_cur;
+            fin.read(reinterpret_cast<char *>(&ne_cur), sizeof(ne_cur));
+            t.ne[i] = ne_cur;
+            nelements *= t.ne[i];
+        }
+
+        t.name.resize(length);
+        fin.read(&t.name[0], length);
+
+        const ggml_type type = bert_ftype_to_type(t.ftype);
+        if (type == GGML_TYPE_COUNT)
+        {
+            fprintf(stderr, "%s: unknown ftype %d in model file\n", __func__, t.ftype);
+            return false;
+        }
+        t.offset = fin.tellg();
+        t.size = nelements * ggml_type_size(type) / ggml_blck_size(type);
+        fin.seekg(t.size, std::ios::cur);
+
+        tensors.push_back(std::move(t));
+    }
+}
+
+struct bert_ctx * bert_load_from_file(const char *fname)
+{
+    bert_load_params params;
+    return bert_load_from_file_with_params(fname, params);
+}
+
+struct bert_ctx * bert_load_from_file_with_params(const char *fname, struct bert_load_params load_params)
+{
+    printf("%s: loading model from '%s' - please wait ...\n", __func__, fname);
 
     auto fin = std::ifstream(fname, std::ios::binary);
     if (!fin)
@@ -339,21 +1904,53 @@ struct bert_ctx * bert_load_from_file(const char *fname)
         return nullptr;
     }
 
+    fin.seekg(0, std::ios::end);
+    const size_t file_size = fin.tellg();
+    fin.seekg(0, std::ios::beg);
+
     // verify magic
+    uint32_t version = 0;
+    uint32_t alignment = 1;
+    uint32_t n_file_tensors = 0;
     {
         uint32_t magic;
         fin.read((char *)&magic, sizeof(magic));
-        if (magic != 0x67676d6c)
+        if (magic == BERT_FILE_MAGIC)
+        {
+            fin.read((char *)&version, sizeof(version));
+            fin.read((char *)&alignment, sizeof(alignment));
+            fin.read((char *)&n_file_tensors, sizeof(n_file_tensors));
+            if (version > BERT_FILE_VERSION || alignment == 0)
+            {
+                fprintf(stderr, "%s: unsupported model file '%s' (version %u)\n", __func__, fname, version);
+                return nullptr;
+            }
+        }
+        else if (magic != BERT_FILE_MAGIC_LEGACY)
         {
             fprintf(stderr, "%s: invalid model file '%s' (bad magic)\n", __func__, fname);
             return nullptr;
         }
     }
+    // legacy files store q, k and v separately
+    const bool legacy = version == 0;
 
     bert_ctx * new_bert = new bert_ctx;
     bert_model & model = new_bert->model;
     bert_vocab & vocab = new_bert->vocab;
 
+    // without mmap support the weights are read quietly
+    if (load_params.use_mmap && bert_mmap::supported)
+    {
+        model.mapping = std::make_unique<bert_mmap>();
+        if (!model.mapping->map(fname, load_params.prefetch))
+        {
+            fprintf(stderr, "%s: failed to mmap '%s', reading it instead\n", __func__, fname);
+            model.mapping.reset();
+        }
+    }
+    const bool use_mmap = model.mapping != nullptr;
+
     // load hparams
     {
         auto &hparams = model.hparams;
@@ -379,27 +1976,26 @@ struct bert_ctx * bert_load_from_file(const char *fname)
     {
         int32_t n_vocab = model.hparams.n_vocab;
 
-        std::string word;
+        vocab.offsets.reserve(n_vocab + 1);
+        vocab.offsets.push_back(0);
         for (int i = 0; i < n_vocab; i++)
         {
             uint32_t len;
             fin.read((char *)&len, sizeof(len));
 
-            word.resize(len);
-            fin.read((char *)word.data(), len);
-
-            if (word[0] == '#' && word[1] == '#')
-            {
-                vocab.subword_token_to_id[word.substr(2)] = i;
-                vocab._id_to_subword_token[i] = word;
-            }
-
-            if (vocab.token_to_id.count(word) == 0)
-            {
-                vocab.token_to_id[word] = i;
-                vocab._id_to_token[i] = word;
-            }
+            const size_t offset = vocab.text.size();
+            vocab.text.resize(offset + len + 1);
+            fin.read(&vocab.text[offset], len);
+            vocab.offsets.push_back(vocab.text.size());
+        }
+        if (!fin)
+        {
+            fprintf(stderr, "%s: invalid model file '%s' (bad vocab)\n", __func__, fname);
+            bert_free(new_bert);
+            return nullptr;
         }
+
+        vocab.build();
     }
 
     // for the big tensors, we have the option to store the data in 16-bit floats or quantized
@@ -431,6 +2027,7 @@ struct bert_ctx * bert_load_from_file(const char *fname)
     auto &ctx = model.ctx;
 
     size_t model_mem_req = 0;
+    size_t qkv_mem_req = 0;
 
     {
         const auto &hparams = model.hparams;
@@ -451,16 +2048,26 @@ struct bert_ctx * bert_load_from_file(const char *fname)
 
         model_mem_req += 4 * n_layer * (n_embd * ggml_type_sizef(GGML_TYPE_F32)); // ln_*
 
-        model_mem_req += 4 * n_layer * (n_embd * n_embd * ggml_type_sizef(wtype)); // kqvo weights
-        model_mem_req += 4 * n_layer * (n_embd * ggml_type_sizef(GGML_TYPE_F32)); // kqvo bias
+        qkv_mem_req += 3 * n_layer * (n_embd * n_embd * ggml_type_sizef(wtype)); // qkv weights
+        qkv_mem_req += 3 * n_layer * (n_embd * ggml_type_sizef(GGML_TYPE_F32)); // qkv bias
+        model_mem_req += qkv_mem_req;
+
+        model_mem_req += n_layer * (n_embd * n_embd * ggml_type_sizef(wtype)); // o weights
+        model_mem_req += n_layer * (n_embd * ggml_type_sizef(GGML_TYPE_F32)); // o bias
 
         model_mem_req += 2 * n_layer * (n_embd * n_intermediate * ggml_type_sizef(wtype)); // ff_*_w
         model_mem_req += n_layer * (n_intermediate * ggml_type_sizef(GGML_TYPE_F32)); // ff_i_b
         model_mem_req += n_layer * (n_embd * ggml_type_sizef(GGML_TYPE_F32)); // ff_o_b
 
-        model_mem_req += (5 + 16 * n_layer) * 512; // object overhead
+        if (use_mmap)
+        {
+            // only q, k and v of legacy files are copied out of the file, they are stored separately but used fused
+            model_mem_req = legacy ? qkv_mem_req : 0;
+        }
 
-        printf("%s: ggml ctx size = %6.2f MB\n", __func__, model_mem_req / (1024.0 * 1024.0));
+        model_mem_req += (5 + 18 * n_layer) * 512; // object overhead
+
+        printf("%s: ggml ctx size = %6.2f MB%s\n", __func__, model_mem_req / (1024.0 * 1024.0), use_mmap ? " (mmap)" : "");
     }
 
     // create the ggml context
@@ -468,7 +2075,7 @@ struct bert_ctx * bert_load_from_file(const char *fname)
         struct ggml_init_params params = {
             .mem_size = model_mem_req,
             .mem_buffer = NULL,
-            .no_alloc = false,
+            .no_alloc = use_mmap,
         };
 
         model.ctx = ggml_init(params);
@@ -516,12 +2123,31 @@ struct bert_ctx * bert_load_from_file(const char *fname)
             layer.ln_out_w = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
             layer.ln_out_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
 
-            layer.q_w = ggml_new_tensor_2d(ctx, wtype, n_embd, n_embd);
-            layer.q_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
-            layer.k_w = ggml_new_tensor_2d(ctx, wtype, n_embd, n_embd);
-            layer.k_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
-            layer.v_w = ggml_new_tensor_2d(ctx, wtype, n_embd, n_embd);
-            layer.v_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
+            if (legacy)
+            {
+                // q, k and v are loaded straight into consecutive rows of one tensor,
+                // so that the projection is a single matmul
+                ggml_set_no_alloc(ctx, false);
+                layer.qkv_w = ggml_new_tensor_2d(ctx, wtype, n_embd, 3 * n_embd);
+                layer.qkv_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, 3 * n_embd);
+                ggml_set_no_alloc(ctx, use_mmap);
+
+                const size_t w_size = n_embd * layer.qkv_w->nb[1];
+                const size_t b_size = n_embd * layer.qkv_b->nb[0];
+
+                layer.q_w = ggml_view_2d(ctx, layer.qkv_w, n_embd, n_embd, layer.qkv_w->nb[1], 0 * w_size);
+                layer.q_b = ggml_view_1d(ctx, layer.qkv_b, n_embd, 0 * b_size);
+                layer.k_w = ggml_view_2d(ctx, layer.qkv_w, n_embd, n_embd, layer.qkv_w->nb[1], 1 * w_size);
+                layer.k_b = ggml_view_1d(ctx, layer.qkv_b, n_embd, 1 * b_size);
+                layer.v_w = ggml_view_2d(ctx, layer.qkv_w, n_embd, n_embd, layer.qkv_w->nb[1], 2 * w_size);
+                layer.v_b = ggml_view_1d(ctx, layer.qkv_b, n_embd, 2 * b_size);
+            }
+            else
+            {
+                // stored fused in the file
+                layer.qkv_w = ggml_new_tensor_2d(ctx, wtype, n_embd, 3 * n_embd);
+                layer.qkv_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, 3 * n_embd);
+            }
             layer.o_w = ggml_new_tensor_2d(ctx, wtype, n_embd, n_embd);
             layer.o_b = ggml_new_tensor_1d(ctx, GGML_TYPE_F32, n_embd);
 
@@ -533,12 +2159,20 @@ struct bert_ctx * bert_load_from_file(const char *fname)
 
             // map by name
 
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.query.weight"] = layer.q_w;
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.query.bias"] = layer.q_b;
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.key.weight"] = layer.k_w;
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.key.bias"] = layer.k_b;
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.value.weight"] = layer.v_w;
-            model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.value.bias"] = layer.v_b;
+            if (legacy)
+            {
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.query.weight"] = layer.q_w;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.query.bias"] = layer.q_b;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.key.weight"] = layer.k_w;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.key.bias"] = layer.k_b;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.value.weight"] = layer.v_w;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.value.bias"] = layer.v_b;
+            }
+            else
+            {
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.qkv.weight"] = layer.qkv_w;
+                model.tensors["encoder.layer." + std::to_string(i) + ".attention.self.qkv.bias"] = layer.qkv_b;
+            }
             model.tensors["encoder.layer." + std::to_string(i) + ".attention.output.LayerNorm.weight"] = layer.ln_att_w;
             model.tensors["encoder.layer." + std::to_string(i) + ".attention.output.LayerNorm.bias"] = layer.ln_att_b;
             model.tensors["encoder.layer." + std::to_string(i) + ".attention.output.dense.weight"] = layer.o_w;
@@ -559,35 +2193,38 @@ struct bert_ctx * bert_load_from_file(const char *fname)
         int n_tensors = 0;
         size_t total_size = 0;
 
-        printf("%s: ", __func__);
-
-        while (true)
+        std::vector<bert_file_tensor> file_tensors;
+        const bool ok = legacy ? bert_scan_tensor_records(fin, file_tensors)
+                               : bert_read_tensor_directory(fin, n_file_tensors, alignment, file_tensors);
+        if (!ok)
         {
-            int32_t n_dims;
-            int32_t length;
-            int32_t ftype;
-
-            fin.read(reinterpret_cast<char *>(&n_dims), sizeof(n_dims));
-            fin.read(reinterpret_cast<char *>(&length), sizeof(length));
-            fin.read(reinterpret_cast<char *>(&ftype), sizeof(ftype));
+            fprintf(stderr, "%s: invalid tensor list in model file '%s'\n", __func__, fname);
+            bert_free(new_bert);
+            return nullptr;
+        }
+        fin.clear();
 
-            if (fin.eof())
+        // catch truncated files before reading any data
+        for (const auto & t : file_tensors)
+        {
+            if (t.offset + t.size > file_size)
             {
-                break;
+                fprintf(stderr, "%s: model file '%s' is truncated, tensor '%s' ends at %zu of %zu bytes\n",
+                        __func__, fname, t.name.data(), t.offset + t.size, file_size);
+                bert_free(new_bert);
+                return nullptr;
             }
+        }
 
-            int64_t nelements = 1;
-            int64_t ne[2] = {1, 1};
-            for (int i = 0; i < n_dims; ++i)
-            {
-                int32_t ne_cur;
-                fin.read(reinterpret_cast<char *>(&ne_cur), sizeof(ne_cur));
-                ne[i] = ne_cur;
-                nelements *= ne[i];
-            }
+        printf("%s: ", __func__);
 
-            std::string name(length, 0);
-            fin.read(&name[0], length);
+        // tensors of the model not read yet, a truncated legacy file just ends early
+        auto missing = model.tensors;
+        for (const auto & t : file_tensors)
+        {
+            const std::string & name = t.name;
+            const int64_t * ne = t.ne;
+            const int64_t nelements = ne[0] * ne[1];
 
             if (model.tensors.find(name.data()) == model.tensors.end())
             {
@@ -596,6 +2233,13 @@ struct bert_ctx * bert_load_from_file(const char *fname)
                 return nullptr;
             }
 
+            if (missing.erase(name) == 0)
+            {
+                fprintf(stderr, "%s: tensor '%s' appears twice in model file\n", __func__, name.data());
+                bert_free(new_bert);
+                return nullptr;
+            }
+
             auto tensor = model.tensors[name.data()];
             if (ggml_nelements(tensor) != nelements)
             {
@@ -620,403 +2264,1186 @@ struct bert_ctx * bert_load_from_file(const char *fname)
                     "q4_0",
                     "q4_1",
                 };
-                printf("%24s - [%5lld, %5lld], type = %6s, %6.2f MB, %9zu bytes\n", name.data(), ne[0], ne[1], ftype_str[ftype], ggml_nbytes(tensor) / 1024.0 / 1024.0, ggml_nbytes(tensor));
+                printf("%24s - [%5lld, %5lld], type = %6s, %6.2f MB, %9zu bytes\n", name.data(), ne[0], ne[1], ftype_str[t.ftype], ggml_nbytes(tensor) / 1024.0 / 1024.0, ggml_nbytes(tensor));
             }
 
-            size_t bpe = 0;
-
-            switch (ftype)
+            const ggml_type type = bert_ftype_to_type(t.ftype);
+            if (type == GGML_TYPE_COUNT)
+            {
+                fprintf(stderr, "%s: unknown ftype %d in model file\n", __func__, t.ftype);
+                bert_free(new_bert);
+                return nullptr;
+            }
+            if (type == GGML_TYPE_Q4_0 || type == GGML_TYPE_Q4_1)
             {
-            case 0:
-                bpe = ggml_type_size(GGML_TYPE_F32);
-                break;
-            case 1:
-                bpe = ggml_type_size(GGML_TYPE_F16);
-                break;
-            case 2:
-                bpe = ggml_type_size(GGML_TYPE_Q4_0);
-                assert(ne[0] % 64 == 0);
-                break;
-            case 3:
-                bpe = ggml_type_size(GGML_TYPE_Q4_1);
                 assert(ne[0] % 64 == 0);
-                break;
-            default:
+            }
+
+            if (type != tensor->type)
+            {
+                fprintf(stderr, "%s: tensor '%s' has wrong type in model file: got %s, expected %s\n",
+                        __func__, name.data(), ggml_type_name(type), ggml_type_name(tensor->type));
+                bert_free(new_bert);
+                return nullptr;
+            }
+
+            if (t.size != ggml_nbytes(tensor))
             {
-                fprintf(stderr, "%s: unknown ftype %d in model file\n", __func__, ftype);
+                fprintf(stderr, "%s: tensor '%s' has wrong size in model file: got %zu, expected %zu\n",
+                        __func__, name.data(), t.size, ggml_nbytes(tensor));
                 bert_free(new_bert);
                 return nullptr;
             }
-            };
 
-            if ((nelements * bpe) / ggml_blck_size(tensor->type) != ggml_nbytes(tensor))
-            {
-                fprintf(stderr, "%s: tensor '%s' has wrong size in model file: got %zu, expected %llu\n",
-                        __func__, name.data(), ggml_nbytes(tensor), nelements * bpe);
-                bert_free(new_bert);
-                return nullptr;
-            }
+            if (tensor->data == nullptr)
+            {
+                // mapped, the data stays in the file
+                tensor->data = (uint8_t *) model.mapping->addr + t.offset;
+            }
+            else
+            {
+                fin.seekg(t.offset);
+                fin.read(reinterpret_cast<char *>(tensor->data), ggml_nbytes(tensor));
+            }
+
+            // printf("%42s - [%5d, %5d], type = %6s, %6.2f MB\n", name.data(), ne[0], ne[1], ftype == 0 ? "float" : "f16", ggml_nbytes(tensor)/1024.0/1024.0);
+            total_size += ggml_nbytes(tensor);
+            if (++n_tensors % 8 == 0)
+            {
+                printf(".");
+                fflush(stdout);
+            }
+        }
+
+        printf(" done\n");
+
+        if (!missing.empty())
+        {
+            fprintf(stderr, "%s: model file '%s' is missing %zu tensors, the first is '%s'\n",
+                    __func__, fname, missing.size(), missing.begin()->first.c_str());
+            bert_free(new_bert);
+            return nullptr;
+        }
+
+        printf("%s: model size = %8.2f MB / num tensors = %d\n", __func__, total_size / 1024.0 / 1024.0, n_tensors);
+    }
+
+    fin.close();
+
+    // Calculate space requirements for setting up context buffers later
+    {
+        auto graph = std::make_unique<bert_graph>();
+        graph->mode = BERT_BATCH_PADDED;
+        graph->N = 4;
+        graph->n_batch = 1;
+        graph->fused_attn = false;
+
+        // TODO: We set the initial buffer size to 32MB and hope it's enough. Maybe there is a better way to do this?
+        graph->buf.resize(32 * 1024 * 1024);
+        struct ggml_init_params params = {
+            .mem_size = graph->buf.size,
+            .mem_buffer = graph->buf.data,
+            .no_alloc = false,
+        };
+        graph->ctx = ggml_init(params);
+        bert_build_graph(model, *graph);
+        new_bert->mem_per_token = ggml_used_mem(graph->ctx) / graph->N;
+
+        // TODO: Max tokens should be a param?
+        int32_t N = new_bert->model.hparams.n_max_tokens;
+        new_bert->mem_per_input = bert_graph_mem(new_bert, BERT_BATCH_PADDED, N, 1);
+
+        // default budget of bert_encode_batch, see bert_set_max_batch_tokens
+        new_bert->max_batch_tokens = 4 * N;
+    }
+    new_bert->state.reset(bert_state_new(new_bert));
+    printf("%s: mem_per_token %zu KB, mem_per_input %lld MB\n", __func__, new_bert->mem_per_token / (1 << 10), new_bert->mem_per_input / (1 << 20));
+
+    return new_bert;
+}
+
+void bert_free(bert_ctx * ctx) {
+    ggml_free(ctx->model.ctx);
+    delete ctx;
+}
+
+void bert_eval(
+    struct bert_ctx *ctx,
+    int32_t n_threads,
+    bert_vocab_id *tokens,
+    int32_t n_tokens,
+    float *embeddings)
+{
+    bert_eval_batch(ctx, n_threads, 1, &tokens, &n_tokens, &embeddings);
+}
+
+// soft_max over the rows of a (key positions) that ignores the padding of each sequence.
+// b holds the number of real tokens of each sequence in the batch (a->ne[3] entries).
+static void bert_soft_max_masked_f32(
+    struct ggml_tensor * dst,
+    const struct ggml_tensor * a,
+    const struct ggml_tensor * b,
+    int ith,
+    int nth,
+    void * userdata)
+{
+    GGML_ASSERT(ggml_is_contiguous(a));
+    GGML_ASSERT(ggml_is_contiguous(dst));
+
+    const int64_t ne0 = a->ne[0];
+    const int64_t nr = ggml_nrows(a);
+    const int64_t rows_per_seq = a->ne[1] * a->ne[2];
+    const int32_t * lengths = (const int32_t *) b->data;
+
+    // rows per thread
+    const int64_t dr = (nr + nth - 1) / nth;
+    const int64_t ir0 = dr * ith;
+    const int64_t ir1 = std::min(ir0 + dr, nr);
+
+    for (int64_t ir = ir0; ir < ir1; ir++)
+    {
+        const int64_t n = lengths[ir / rows_per_seq];
+        const float * x = (const float *) ((const char *) a->data + ir * a->nb[1]);
+        float * y = (float *) ((char *) dst->data + ir * dst->nb[1]);
+
+        float max = -INFINITY;
+        for (int64_t i = 0; i < n; i++)
+        {
+            max = std::max(max, x[i]);
+        }
+
+        double sum = 0.0;
+        for (int64_t i = 0; i < n; i++)
+        {
+            y[i] = expf(x[i] - max);
+            sum += y[i];
+        }
+
+        const float scale = 1.0f / sum;
+        for (int64_t i = 0; i < n; i++)
+        {
+            y[i] *= scale;
+        }
+        for (int64_t i = n; i < ne0; i++)
+        {
+            y[i] = 0.0f;
+        }
+    }
+}
+
+// dst = a + b, b is a bias row broadcast over the rows of a
+static void bert_add_bias_f32(
+    struct ggml_tensor * dst,
+    const struct ggml_tensor * a,
+    const struct ggml_tensor * b,
+    int ith,
+    int nth,
+    void * userdata)
+{
+    GGML_ASSERT(ggml_is_contiguous(a));
+    GGML_ASSERT(b->ne[0] == a->ne[0]);
+
+    const int64_t ne0 = a->ne[0];
+    const int64_t nr = ggml_nrows(a);
+    const float * bias = (const float *) b->data;
+
+    // rows per thread
+    const int64_t dr = (nr + nth - 1) / nth;
+    const int64_t ir0 = dr * ith;
+    const int64_t ir1 = std::min(ir0 + dr, nr);
+
+    for (int64_t ir = ir0; ir < ir1; ir++)
+    {
+        const float * x = (const float *) ((const char *) a->data + ir * a->nb[1]);
+        float * y = (float *) ((char *) dst->data + ir * dst->nb[1]);
+        for (int64_t i = 0; i < ne0; i++)
+        {
+            y[i] = x[i] + bias[i];
+        }
+    }
+}
+
+// dst = norm(a) * w + b, every row of a is normalized, w and b are rows broadcast over a
+static void bert_norm_f32(
+    struct ggml_tensor * dst,
+    const struct ggml_tensor * a,
+    const struct ggml_tensor * w,
+    const struct ggml_tensor * b,
+    int ith,
+    int nth,
+    void * userdata)
+{
+    GGML_ASSERT(ggml_is_contiguous(a));
+    GGML_ASSERT(w->ne[0] == a->ne[0] && b->ne[0] == a->ne[0]);
+
+    const float eps = 1e-5f; // same as ggml_norm
+    const int64_t ne0 = a->ne[0];
+    const int64_t nr = ggml_nrows(a);
+    const float * weight = (const float *) w->data;
+    const float * bias = (const float *) b->data;
+
+    // rows per thread
+    const int64_t dr = (nr + nth - 1) / nth;
+    const int64_t ir0 = dr * ith;
+    const int64_t ir1 = std::min(ir0 + dr, nr);
+
+    for (int64_t ir = ir0; ir < ir1; ir++)
+    {
+        const float * x = (const float *) ((const char *) a->data + ir * a->nb[1]);
+        float * y = (float *) ((char *) dst->data + ir * dst->nb[1]);
+
+        double sum = 0.0;
+        for (int64_t i = 0; i < ne0; i++)
+        {
+            sum += x[i];
+        }
+        const float mean = sum / ne0;
+
+        double sum2 = 0.0;
+        for (int64_t i = 0; i < ne0; i++)
+        {
+            const float v = x[i] - mean;
+            sum2 += v * v;
+        }
+        const float scale = 1.0f / sqrtf(sum2 / ne0 + eps);
+
+        for (int64_t i = 0; i < ne0; i++)
+        {
+            y[i] = (x[i] - mean) * scale * weight[i] + bias[i];
+        }
+    }
+}
+
+// cur + b without materializing ggml_repeat(b), overwrites cur
+static struct ggml_tensor * bert_add_bias(struct ggml_context * ctx0, struct ggml_tensor * cur, struct ggml_tensor * b)
+{
+    return ggml_map_custom2_inplace(ctx0, cur, b, bert_add_bias_f32, GGML_N_TASKS_MAX, nullptr);
+}
+
+// LayerNorm with its affine transform as one op, overwrites cur
+static struct ggml_tensor * bert_norm(struct ggml_context * ctx0, struct ggml_tensor * cur, struct ggml_tensor * w, struct ggml_tensor * b)
+{
+    return ggml_map_custom3_inplace(ctx0, cur, w, b, bert_norm_f32, GGML_N_TASKS_MAX, nullptr);
+}
+
+static inline float bert_vec_dot_f32(const float * x, const float * y, int64_t n)
+{
+    int64_t i = 0;
+    float sum = 0.0f;
+#if defined(__AVX__) && defined(__FMA__)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), acc1);
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    __m128 acc = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    acc = _mm_hadd_ps(acc, acc);
+    acc = _mm_hadd_ps(acc, acc);
+    sum = _mm_cvtss_f32(acc);
+#else
+    float sum4[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (; i + 4 <= n; i += 4)
+    {
+        sum4[0] += x[i + 0] * y[i + 0];
+        sum4[1] += x[i + 1] * y[i + 1];
+        sum4[2] += x[i + 2] * y[i + 2];
+        sum4[3] += x[i + 3] * y[i + 3];
+    }
+    sum = (sum4[0] + sum4[1]) + (sum4[2] + sum4[3]);
+#endif
+    for (; i < n; i++)
+    {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+// y = y * s + p * x
+static inline void bert_vec_scale_mad_f32(float * y, float s, float p, const float * x, int64_t n)
+{
+    for (int64_t i = 0; i < n; i++)
+    {
+        y[i] = y[i] * s + p * x[i];
+    }
+}
+
+// Fused self-attention, softmax(Q K^T / sqrt(d_head)) V with an online softmax over tiles of keys.
+// Neither the attention scores nor a transposed V are materialized.
+// q, k, v are [d_head, n_head, T], the tokens are split into segments that only attend to themselves.
+// userdata is an I32 tensor with the first token of every segment and T as its last entry.
+#define BERT_ATTN_Q_TILE 8
+#define BERT_ATTN_K_TILE 64
+#define BERT_ATTN_MAX_D_HEAD 256
+
+static void bert_attn_f32(
+    struct ggml_tensor * dst,
+    const struct ggml_tensor * q,
+    const struct ggml_tensor * k,
+    const struct ggml_tensor * v,
+    int ith,
+    int nth,
+    void * userdata)
+{
+    const struct ggml_tensor * starts = (const struct ggml_tensor *) userdata;
+    const int32_t * off = (const int32_t *) starts->data;
+    const int64_t n_seq = starts->ne[0] - 1;
+
+    const int64_t d_head = q->ne[0];
+    const int64_t n_head = q->ne[1];
+    const int64_t T = q->ne[2];
+    const float scale = 1.0f / sqrtf((float) d_head);
+
+    GGML_ASSERT(d_head <= BERT_ATTN_MAX_D_HEAD);
+
+    float S[BERT_ATTN_Q_TILE][BERT_ATTN_K_TILE];
+    float M[BERT_ATTN_Q_TILE];
+    float L[BERT_ATTN_Q_TILE];
+    float acc[BERT_ATTN_Q_TILE][BERT_ATTN_MAX_D_HEAD];
+
+    // (head, token) rows per thread, consecutive rows share a head
+    const int64_t nr = n_head * T;
+    const int64_t dr = (nr + nth - 1) / nth;
+    const int64_t ir0 = dr * ith;
+    const int64_t ir1 = std::min(ir0 + dr, nr);
+
+    for (int64_t ir = ir0; ir < ir1;)
+    {
+        const int64_t h = ir / T;
+        const int64_t t0 = ir % T;
+
+        // keys of the segment of the query
+        const int64_t s = std::upper_bound(off, off + n_seq + 1, (int32_t) t0) - off - 1;
+        const int64_t j0 = off[s];
+        const int64_t j1 = off[s + 1];
+
+        // a tile of queries from the same segment and head
+        const int64_t nq = std::min({(int64_t) BERT_ATTN_Q_TILE, ir1 - ir, j1 - t0});
+
+        const float * qr[BERT_ATTN_Q_TILE];
+        for (int64_t iq = 0; iq < nq; iq++)
+        {
+            qr[iq] = (const float *) ((const char *) q->data + (t0 + iq) * q->nb[2] + h * q->nb[1]);
+            M[iq] = -INFINITY;
+            L[iq] = 0.0f;
+            memset(acc[iq], 0, d_head * sizeof(float));
+        }
+
+        for (int64_t jb = j0; jb < j1; jb += BERT_ATTN_K_TILE)
+        {
+            const int64_t nk = std::min((int64_t) BERT_ATTN_K_TILE, j1 - jb);
+
+            for (int64_t iq = 0; iq < nq; iq++)
+            {
+                float max = M[iq];
+                for (int64_t ik = 0; ik < nk; ik++)
+                {
+                    const float * kr = (const float *) ((const char *) k->data + (jb + ik) * k->nb[2] + h * k->nb[1]);
+                    S[iq][ik] = bert_vec_dot_f32(qr[iq], kr, d_head) * scale;
+                    max = std::max(max, S[iq][ik]);
+                }
+
+                // rescale what was accumulated with the previous max
+                const float corr = expf(M[iq] - max);
+                float sum = L[iq] * corr;
+                for (int64_t ik = 0; ik < nk; ik++)
+                {
+                    const float p = expf(S[iq][ik] - max);
+                    const float * vr = (const float *) ((const char *) v->data + (jb + ik) * v->nb[2] + h * v->nb[1]);
+                    bert_vec_scale_mad_f32(acc[iq], ik == 0 ? corr : 1.0f, p, vr, d_head);
+                    sum += p;
+                }
+                M[iq] = max;
+                L[iq] = sum;
+            }
+        }
+
+        for (int64_t iq = 0; iq < nq; iq++)
+        {
+            float * y = (float *) ((char *) dst->data + (t0 + iq) * dst->nb[2] + h * dst->nb[1]);
+            const float norm = 1.0f / L[iq];
+            for (int64_t i = 0; i < d_head; i++)
+            {
+                y[i] = acc[iq][i] * norm;
+            }
+        }
+
+        ir += nq;
+    }
+}
+
+// Builds the encoder graph for the shape of graph (mode, N, n_batch) in graph.ctx.
+// The inputs are allocated but not set, see bert_set_graph_inputs.
+static void bert_build_graph(const bert_model & model, bert_graph & graph)
+{
+    const auto &hparams = model.hparams;
+
+    const int n_embd = hparams.n_embd;
+    const int n_layer = hparams.n_layer;
+    const int n_head = hparams.n_head;
+
+    const int d_head = n_embd / n_head;
+
+    // padded: all inputs are padded to N tokens
+    // packed: inputs are concatenated one after another into N tokens
+    const bool packed = graph.mode == BERT_BATCH_PACKED;
+    const int N = graph.N;
+    const int n_batch = graph.n_batch;
+    // number of token rows in the graph
+    const int T = packed ? N : N * n_batch;
+
+    struct ggml_context *ctx0 = graph.ctx;
+
+    // Embeddings. word_embeddings + token_type_embeddings + position_embeddings
+    graph.token_layer = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, T);
+
+    struct ggml_tensor *token_types = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, T);
+    ggml_set_zero(token_types);
+
+    graph.positions = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, T);
+
+    // padded: number of real tokens per input, masks the padding in attention
+    graph.lengths = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, n_batch);
+
+    // fused attention: first token of every segment that attends only to itself,
+    // the inputs and their padding (padded) or the inputs and the trailing padding (packed)
+    graph.starts = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, (packed ? n_batch : 2 * n_batch) + 2);
+
+    // mean pooling weights, 1/n for the tokens of an input and 0 elsewhere
+    graph.pooling = packed ? ggml_new_tensor_2d(ctx0, GGML_TYPE_F32, T, n_batch)
+                           : ggml_new_tensor_3d(ctx0, GGML_TYPE_F32, N, 1, n_batch);
+
+    struct ggml_tensor *inpL = ggml_get_rows(ctx0, model.word_embeddings, graph.token_layer);
+
+    inpL = ggml_add(ctx0,
+                    ggml_get_rows(ctx0, model.token_type_embeddings, token_types),
+                    inpL);
+    inpL = ggml_add(ctx0,
+                    ggml_get_rows(ctx0, model.position_embeddings, graph.positions),
+                    inpL);
+
+    // embd norm
+    inpL = bert_norm(ctx0, inpL, model.ln_e_w, model.ln_e_b);
+
+    // layers
+    for (int il = 0; il < n_layer; il++)
+    {
+        struct ggml_tensor *cur = inpL;
+
+        // fused q, k and v projection, [3 * n_embd, T]
+        struct ggml_tensor *QKV = bert_add_bias(ctx0,
+                                                ggml_mul_mat(ctx0, model.layers[il].qkv_w, cur),
+                                                model.layers[il].qkv_b);
+        const size_t nb_head = d_head * ggml_element_size(QKV);
+
+        // self-attention
+        if (graph.fused_attn)
+        {
+            struct ggml_tensor *Q = ggml_view_3d(ctx0, QKV, d_head, n_head, T, nb_head, QKV->nb[1], 0 * n_head * nb_head);
+            struct ggml_tensor *K = ggml_view_3d(ctx0, QKV, d_head, n_head, T, nb_head, QKV->nb[1], 1 * n_head * nb_head);
+            struct ggml_tensor *V = ggml_view_3d(ctx0, QKV, d_head, n_head, T, nb_head, QKV->nb[1], 2 * n_head * nb_head);
+
+            struct ggml_tensor *KQV = ggml_map_custom3(ctx0, Q, K, V, bert_attn_f32, GGML_N_TASKS_MAX, graph.starts);
+            cur = ggml_reshape_2d(ctx0, KQV, n_embd, T);
+        }
+        else
+        {
+            struct ggml_tensor *Qcur = ggml_view_4d(ctx0, QKV, d_head, n_head, N, n_batch,
+                                                    nb_head, QKV->nb[1], N * QKV->nb[1], 0 * n_head * nb_head);
+            struct ggml_tensor *Q = ggml_permute(ctx0, Qcur, 0, 2, 1, 3);
+
+            struct ggml_tensor *Kcur = ggml_view_4d(ctx0, QKV, d_head, n_head, N, n_batch,
+                                                    nb_head, QKV->nb[1], N * QKV->nb[1], 1 * n_head * nb_head);
+            struct ggml_tensor *K = ggml_permute(ctx0, Kcur, 0, 2, 1, 3);
+
+            struct ggml_tensor *Vcur = ggml_view_4d(ctx0, QKV, d_head, n_head, N, n_batch,
+                                                    nb_head, QKV->nb[1], N * QKV->nb[1], 2 * n_head * nb_head);
+            struct ggml_tensor *V = ggml_permute(ctx0, Vcur, 0, 2, 1, 3);
+
+            struct ggml_tensor *KQ = ggml_mul_mat(ctx0, K, Q);
+            // KQ = soft_max(KQ / sqrt(head width)), padded keys get zero weight
+            KQ = ggml_map_custom2(ctx0,
+                                  ggml_scale(ctx0,
+                                             KQ,
+                                             ggml_new_f32(ctx0, 1.0f / sqrt((float)d_head))),
+                                  graph.lengths,
+                                  bert_soft_max_masked_f32, GGML_N_TASKS_MAX, nullptr);
+
+            V = ggml_cont(ctx0, ggml_transpose(ctx0, V));
+            struct ggml_tensor *KQV = ggml_mul_mat(ctx0, V, KQ);
+            KQV = ggml_permute(ctx0, KQV, 0, 2, 1, 3);
+
+            cur = ggml_cpy(ctx0,
+                           KQV,
+                           ggml_new_tensor_2d(ctx0, GGML_TYPE_F32, n_embd, T));
+        }
+        // attention output
+        cur = bert_add_bias(ctx0,
+                            ggml_mul_mat(ctx0, model.layers[il].o_w, cur),
+                            model.layers[il].o_b);
+
+        // re-add the layer input
+        cur = ggml_add(ctx0, cur, inpL);
+
+        // attention norm
+        cur = bert_norm(ctx0, cur, model.layers[il].ln_att_w, model.layers[il].ln_att_b);
+
+        struct ggml_tensor *att_output = cur;
+        // intermediate_output = self.intermediate(attention_output)
+        cur = ggml_mul_mat(ctx0, model.layers[il].ff_i_w, cur);
+        cur = bert_add_bias(ctx0, cur, model.layers[il].ff_i_b);
+        cur = ggml_gelu_inplace(ctx0, cur);
+
+        // layer_output = self.output(intermediate_output, attention_output)
+        cur = ggml_mul_mat(ctx0, model.layers[il].ff_o_w, cur);
+        cur = bert_add_bias(ctx0, cur, model.layers[il].ff_o_b);
+        // attentions bypass the intermediate layer
+        cur = ggml_add(ctx0, att_output, cur);
+
+        // output norm
+        cur = bert_norm(ctx0, cur, model.layers[il].ln_out_w, model.layers[il].ln_out_b);
+
+        inpL = cur;
+    }
+    if (packed)
+    {
+        // [n_embd, T] -> [T, n_embd]
+        inpL = ggml_cont(ctx0, ggml_transpose(ctx0, inpL));
+    }
+    else
+    {
+        // [n_embd, N, n_batch] -> [N, n_embd, n_batch]
+        inpL = ggml_cont(ctx0, ggml_transpose(ctx0, ggml_reshape_3d(ctx0, inpL, n_embd, N, n_batch)));
+    }
+    // pooler, [n_embd, n_batch]
+    inpL = ggml_mul_mat(ctx0, inpL, graph.pooling);
+
+    graph.output = inpL;
+    ggml_build_forward_expand(&graph.gf, graph.output);
+}
+
+// Writes the tokens of a batch into the inputs of a graph built for its shape
+static void bert_set_graph_inputs(
+    bert_graph & graph,
+    bert_vocab_id ** batch_tokens,
+    int32_t * n_tokens)
+{
+    const bool packed = graph.mode == BERT_BATCH_PACKED;
+    const int N = graph.N;
+    const int n_batch = graph.n_batch;
+    const int T = packed ? N : N * n_batch;
 
-            fin.read(reinterpret_cast<char *>(tensor->data), ggml_nbytes(tensor));
+    ggml_set_zero(graph.token_layer);
+    ggml_set_zero(graph.positions);
+    ggml_set_zero(graph.pooling);
 
-            // printf("%42s - [%5d, %5d], type = %6s, %6.2f MB\n", name.data(), ne[0], ne[1], ftype == 0 ? "float" : "f16", ggml_nbytes(tensor)/1024.0/1024.0);
-            total_size += ggml_nbytes(tensor);
-            if (++n_tensors % 8 == 0)
-            {
-                printf(".");
-                fflush(stdout);
-            }
+    int32_t offset = 0;
+    for (int ba = 0; ba < n_batch; ba++)
+    {
+        const int n = n_tokens[ba];
+        const int row = packed ? offset : ba * N;
+        const int pool = packed ? ba * T + row : row;
+        memcpy((bert_vocab_id *) graph.token_layer->data + row, batch_tokens[ba], n * ggml_element_size(graph.token_layer));
+        for (int i = 0; i < (packed ? n : N); i++)
+        {
+            ggml_set_i32_1d(graph.positions, row + i, i);
+        }
+        ggml_set_i32_1d(graph.lengths, ba, n);
+        if (packed)
+        {
+            ggml_set_i32_1d(graph.starts, ba, offset);
+        }
+        else
+        {
+            ggml_set_i32_1d(graph.starts, 2 * ba, row);
+            ggml_set_i32_1d(graph.starts, 2 * ba + 1, row + n);
         }
+        for (int i = 0; i < n; i++)
+        {
+            ggml_set_f32_1d(graph.pooling, pool + i, 1.0f / n);
+        }
+        offset += n;
+    }
+    const int n_starts = graph.starts->ne[0];
+    ggml_set_i32_1d(graph.starts, n_starts - 2, packed ? offset : T);
+    ggml_set_i32_1d(graph.starts, n_starts - 1, T);
+}
 
-        printf(" done\n");
+// Finds the cached graph for the batch shape or builds it, evicting the least recently used graphs
+// to stay under the memory limit. Returns nullptr if the graph alone doesn't fit.
+static bert_graph * bert_get_graph(bert_state * state, bert_batch_mode mode, int32_t n_rows, int32_t n_batch)
+{
+    const bert_ctx * ctx = state->ctx;
+    const int32_t N = bert_graph_rows(ctx, mode, n_rows);
+    // packed batches only work with fused attention
+    const bool fused_attn = ctx->fused_attn || mode == BERT_BATCH_PACKED;
+    auto & graphs = state->graphs;
 
-        printf("%s: model size = %8.2f MB / num tensors = %d\n", __func__, total_size / 1024.0 / 1024.0, n_tensors);
+    for (auto & graph : graphs)
+    {
+        if (graph->mode == mode && graph->N == N && graph->n_batch == n_batch && graph->fused_attn == fused_attn)
+        {
+            state->graph_stats.n_hits++;
+            state->graph_stats.last_mem_size = graph->buf.size;
+            graph->last_used = ++state->graph_clock;
+            return graph.get();
+        }
     }
+    state->graph_stats.n_misses++;
 
-    fin.close();
-
-    // Calculate space requirements for setting up context buffers later
+    const int64_t mem_size = bert_graph_mem(ctx, mode, N, n_batch);
+    if (mem_size > BERT_MAX_COMPUTE_MEM)
     {
-        bert_vocab_id tokens[] = {0, 1, 2, 3};
-        // TODO: We set the initial buffer size to 32MB and hope it's enough. Maybe there is a better way to do this?
-        new_bert->buf_compute.resize(32 * 1024 * 1024);
-        bert_eval(new_bert, 1, tokens, 4, nullptr);
-        new_bert->max_batch_n = 0;
+        return nullptr;
+    }
 
-        // TODO: Max tokens should be a param?
-        int32_t N = new_bert->model.hparams.n_max_tokens;
-        new_bert->mem_per_input = 1.1 * (new_bert->mem_per_token * N); // add 10% to account for ggml object overhead
+    int64_t mem_cached = 0;
+    for (const auto & graph : graphs)
+    {
+        mem_cached += graph->buf.size;
+    }
+    while (!graphs.empty() && (graphs.size() >= BERT_MAX_GRAPHS || mem_cached + mem_size > BERT_MAX_COMPUTE_MEM))
+    {
+        auto lru = std::min_element(graphs.begin(), graphs.end(), [](const auto & a, const auto & b)
+                                    { return a->last_used < b->last_used; });
+        mem_cached -= (*lru)->buf.size;
+        graphs.erase(lru);
+    }
 
+    auto graph = std::make_unique<bert_graph>();
+    graph->mode = mode;
+    graph->N = N;
+    graph->n_batch = n_batch;
+    graph->fused_attn = fused_attn;
+    graph->last_used = ++state->graph_clock;
+
+    graph->buf.resize(mem_size);
+    struct ggml_init_params params = {
+        .mem_size = graph->buf.size,
+        .mem_buffer = graph->buf.data,
+        .no_alloc = false,
+    };
+    graph->ctx = ggml_init(params);
+    if (!graph->ctx)
+    {
+        return nullptr;
     }
-    printf("%s: mem_per_token %zu KB, mem_per_input %lld MB\n", __func__, new_bert->mem_per_token / (1 << 10), new_bert->mem_per_input / (1 << 20));
+    bert_build_graph(ctx->model, *graph);
+    state->graph_stats.last_mem_size = graph->buf.size;
 
-    return new_bert;
+    graphs.push_back(std::move(graph));
+    return graphs.back().get();
 }
 
-void bert_resize_ctx(bert_ctx * ctx, int32_t new_size) {    
-    int64_t buf_size_new = ctx->mem_per_input * new_size;
+// Texts per work item of bert_tokenize_csr, items are claimed by the workers one at a time
+static const int32_t BERT_TOKENIZE_CHUNK = 64;
+
+// Tokenizes the texts on the worker pool of the state. The tokens of text i end up in
+// tokens[offsets[i]] .. tokens[offsets[i + 1] - 1].
+static void bert_tokenize_csr(
+    bert_state * state,
+    int32_t n_threads,
+    int32_t n_inputs,
+    const char ** texts,
+    int32_t n_max_tokens,
+    std::vector<bert_vocab_id> & tokens,
+    std::vector<int64_t> & offsets)
+{
+    bert_ctx * ctx = state->ctx;
+    const int32_t n_chunks = (n_inputs + BERT_TOKENIZE_CHUNK - 1) / BERT_TOKENIZE_CHUNK;
+
+    // every chunk collects its tokens on its own, they are concatenated in order afterwards
+    std::vector<std::vector<bert_vocab_id>> chunk_tokens(n_chunks);
+    offsets.assign(n_inputs + 1, 0);
+    std::atomic<int32_t> next_chunk{0};
+
+    auto tokenize = [&](int, int)
+    {
+        std::vector<bert_vocab_id> buf(std::max(n_max_tokens, 2));
+        for (int32_t c; (c = next_chunk.fetch_add(1, std::memory_order_relaxed)) < n_chunks;)
+        {
+            auto & out = chunk_tokens[c];
+            const int32_t end = std::min(n_inputs, (c + 1) * BERT_TOKENIZE_CHUNK);
+            for (int32_t i = c * BERT_TOKENIZE_CHUNK; i < end; i++)
+            {
+                int32_t n = 0;
+                bert_tokenize(ctx, texts[i], buf.data(), &n, n_max_tokens);
+                out.insert(out.end(), buf.begin(), buf.begin() + n);
+                offsets[i + 1] = n;
+            }
+        }
+    };
+    if (n_chunks > 1) {
+        bert_get_threadpool(state, n_threads).run(tokenize);
+    } else {
+        tokenize(0, 1);
+    }
 
-    // TODO: Max memory should be a param? Now just 1 GB
-    int64_t GB = 1 << 30;
-    //printf("%s: requested_buf_size %lldMB\n", __func__, buf_size_new / (1 << 20));
-    if (buf_size_new > GB) {
-        int32_t adjusted_new_size = GB / ctx->mem_per_input;
-        if (adjusted_new_size < 1) adjusted_new_size = 1;
-        //printf("%s: requested batch size %d, actual new batch size %d\n", __func__, new_size, adjusted_new_size);
-        new_size = adjusted_new_size;
-        buf_size_new = ctx->mem_per_input * new_size;
+    for (int32_t i = 0; i < n_inputs; i++)
+    {
+        offsets[i + 1] += offsets[i];
     }
-    if (new_size > ctx->max_batch_n) {
-        ctx->buf_compute.resize(buf_size_new);
-        ctx->max_batch_n = new_size;
+    tokens.resize(offsets[n_inputs]);
+    for (int32_t c = 0; c < n_chunks; c++)
+    {
+        std::copy(chunk_tokens[c].begin(), chunk_tokens[c].end(), tokens.begin() + offsets[c * BERT_TOKENIZE_CHUNK]);
     }
 }
 
-void bert_free(bert_ctx * ctx) {
-    ggml_free(ctx->model.ctx);
-    delete ctx;
+struct bert_tokens bert_state_tokenize_batch(
+    struct bert_state * state,
+    int32_t n_threads,
+    int32_t n_inputs,
+    const char ** texts,
+    int32_t n_max_tokens)
+{
+    std::vector<bert_vocab_id> tokens;
+    std::vector<int64_t> offsets;
+    bert_tokenize_csr(state, n_threads, n_inputs, texts, n_max_tokens, tokens, offsets);
+
+    bert_tokens result;
+    result.n_inputs = n_inputs;
+    result.tokens = (bert_vocab_id *) malloc(std::max<size_t>(tokens.size(), 1) * sizeof(bert_vocab_id));
+    result.offsets = (int64_t *) malloc(offsets.size() * sizeof(int64_t));
+    if (!result.tokens || !result.offsets)
+    {
+        fprintf(stderr, "%s: failed to allocate %zu tokens\n", __func__, tokens.size());
+        bert_tokens_free(result);
+        return {nullptr, nullptr, 0};
+    }
+    std::copy(tokens.begin(), tokens.end(), result.tokens);
+    std::copy(offsets.begin(), offsets.end(), result.offsets);
+    return result;
 }
 
-void bert_eval(
-    struct bert_ctx *ctx,
+struct bert_tokens bert_tokenize_batch(
+    struct bert_ctx * ctx,
     int32_t n_threads,
-    bert_vocab_id *tokens,
-    int32_t n_tokens,
-    float *embeddings)
+    int32_t n_inputs,
+    const char ** texts,
+    int32_t n_max_tokens)
 {
-    bert_eval_batch(ctx, n_threads, 1, &tokens, &n_tokens, embeddings ? &embeddings : nullptr);
+    return bert_state_tokenize_batch(ctx->state.get(), n_threads, n_inputs, texts, n_max_tokens);
 }
 
-void bert_eval_batch(
-    bert_ctx * ctx,
+void bert_tokens_free(struct bert_tokens tokens)
+{
+    free(tokens.tokens);
+    free(tokens.offsets);
+}
+
+void bert_state_eval_batch(
+    bert_state * state,
     int32_t n_threads,
     int32_t n_batch_size,
     bert_vocab_id ** batch_tokens,
     int32_t * n_tokens,
     float ** batch_embeddings)
 {
-    const bert_model& model = ctx->model;
-    bool mem_req_mode = !batch_embeddings;
-    // batch_embeddings is nullptr for the initial memory requirements run
-    if (!mem_req_mode && n_batch_size > ctx->max_batch_n) {
-        bert_resize_ctx(ctx, n_batch_size);
-        if (n_batch_size > ctx->max_batch_n) {
-            fprintf(stderr, "%s: tried to increase buffers to batch size %d but failed\n", __func__, n_batch_size);
-            return;
-        }
-    }
-
-    // TODO: implement real batching
-    for (int ba = 0; ba < n_batch_size; ba++)
-    {
-        const int N = n_tokens[ba];
-        const auto &tokens = batch_tokens[ba];
-
-        const auto &hparams = model.hparams;
-
-        const int n_embd = hparams.n_embd;
-        const int n_layer = hparams.n_layer;
-        const int n_max_tokens = hparams.n_max_tokens;
-        const int n_head = hparams.n_head;
+    const bert_ctx * ctx = state->ctx;
+    const auto &hparams = ctx->model.hparams;
 
-        const int d_head = n_embd / n_head;
+    const int n_embd = hparams.n_embd;
+    const int n_max_tokens = hparams.n_max_tokens;
 
-        std::vector<float> result;
-        if (N > n_max_tokens)
-        {
-            fprintf(stderr, "Too many tokens, maximum is %d\n", n_max_tokens);
-            return;
-        }
+    const bert_batch_mode mode = ctx->batch_mode;
+    const int n_batch = n_batch_size;
+    int N = 0;
+    int T = 0;
+    for (int ba = 0; ba < n_batch; ba++)
+    {
+        N = std::max(N, n_tokens[ba]);
+        T += n_tokens[ba];
+    }
+    if (N > n_max_tokens)
+    {
+        fprintf(stderr, "Too many tokens, maximum is %d\n", n_max_tokens);
+        return;
+    }
 
-        auto & mem_per_token = ctx->mem_per_token;
-        auto & buf_compute   = ctx->buf_compute;
+    bert_graph * graph = bert_get_graph(state, mode, mode == BERT_BATCH_PACKED ? T : N, n_batch);
+    if (!graph) {
+        fprintf(stderr, "%s: tried to increase buffers to batch size %d of %d tokens but failed\n", __func__, n_batch, N);
+        return;
+    }
+    bert_set_graph_inputs(*graph, batch_tokens, n_tokens);
 
-        struct ggml_init_params params = {
-            .mem_size = buf_compute.size,
-            .mem_buffer = buf_compute.data,
-            .no_alloc = false,
-        };
+    // run the computation
+    struct ggml_cplan cplan = ggml_graph_plan(&graph->gf, n_threads);
+    if (cplan.work_size > 0) {
+        graph->work.resize(cplan.work_size);
+        cplan.work_data = graph->work.data();
+    }
+    ggml_graph_compute(&graph->gf, &cplan);
 
-        struct ggml_context *ctx0 = ggml_init(params);
-        struct ggml_cgraph gf = {};
+    // float *dat = ggml_get_data_f32(graph->output);
+    // pretty_print_tensor(dat, graph->output->ne, graph->output->nb, graph->output->n_dims - 1, "");
 
-        // Embeddings. word_embeddings + token_type_embeddings + position_embeddings
-        struct ggml_tensor *token_layer = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, N);
-        memcpy(token_layer->data, tokens, N * ggml_element_size(token_layer));
+    #ifdef GGML_PERF
+        // print timing information per ggml operation (for debugging purposes)
+        // requires GGML_PERF to be defined
+        ggml_graph_print(&graph->gf);
+    #endif
 
-        struct ggml_tensor *token_types = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, N);
-        ggml_set_zero(token_types);
+    for (int ba = 0; ba < n_batch; ba++)
+    {
+        const float * pooled = (const float *) ggml_get_data(graph->output) + ba * n_embd;
 
-        struct ggml_tensor *positions = ggml_new_tensor_1d(ctx0, GGML_TYPE_I32, N);
-        for (int i = 0; i < N; i++)
+        // normalizer
+        double length = 0.0;
+        for (int i = 0; i < n_embd; i++)
         {
-            ggml_set_i32_1d(positions, i, i);
+            length += pooled[i] * pooled[i];
         }
-
-        struct ggml_tensor *inpL = ggml_get_rows(ctx0, model.word_embeddings, token_layer);
-
-        inpL = ggml_add(ctx0,
-                        ggml_get_rows(ctx0, model.token_type_embeddings, token_types),
-                        inpL);
-        inpL = ggml_add(ctx0,
-                        ggml_get_rows(ctx0, model.position_embeddings, positions),
-                        inpL);
-
-        // embd norm
+        const float scale = 1.0f / sqrt(length);
+        for (int i = 0; i < n_embd; i++)
         {
-            inpL = ggml_norm(ctx0, inpL);
-
-            inpL = ggml_add(ctx0,
-                            ggml_mul(ctx0,
-                                     ggml_repeat(ctx0, model.ln_e_w, inpL),
-                                     inpL),
-                            ggml_repeat(ctx0, model.ln_e_b, inpL));
+            batch_embeddings[ba][i] = pooled[i] * scale;
         }
-        // layers
-        for (int il = 0; il < n_layer; il++)
-        {
-            struct ggml_tensor *cur = inpL;
+    }
+}
 
-            // self-attention
-            {
-                struct ggml_tensor *Qcur = cur;
-                Qcur = ggml_reshape_3d(ctx0,
-                                       ggml_add(ctx0, ggml_repeat(ctx0, model.layers[il].q_b, Qcur),
-                                                ggml_mul_mat(ctx0, model.layers[il].q_w, Qcur)),
-                                       d_head, n_head, N);
-                struct ggml_tensor *Q = ggml_permute(ctx0, Qcur, 0, 2, 1, 3);
+void bert_eval_batch(
+    bert_ctx * ctx,
+    int32_t n_threads,
+    int32_t n_batch_size,
+    bert_vocab_id ** batch_tokens,
+    int32_t * n_tokens,
+    float ** batch_embeddings)
+{
+    bert_state_eval_batch(ctx->state.get(), n_threads, n_batch_size, batch_tokens, n_tokens, batch_embeddings);
+}
 
-                struct ggml_tensor *Kcur = cur;
-                Kcur = ggml_reshape_3d(ctx0,
-                                       ggml_add(ctx0, ggml_repeat(ctx0, model.layers[il].k_b, Kcur),
-                                                ggml_mul_mat(ctx0, model.layers[il].k_w, Kcur)),
-                                       d_head, n_head, N);
-                struct ggml_tensor *K = ggml_permute(ctx0, Kcur, 0, 2, 1, 3);
+void bert_state_encode(
+    struct bert_state *state,
+    int32_t n_threads,
+    const char *texts,
+    float *embeddings)
+{
+    bert_state_encode_batch(state, n_threads, 1, 1, &texts, &embeddings);
+}
 
-                struct ggml_tensor *Vcur = cur;
-                Vcur = ggml_reshape_3d(ctx0,
-                                       ggml_add(ctx0, ggml_repeat(ctx0, model.layers[il].v_b, Vcur),
-                                                ggml_mul_mat(ctx0, model.layers[il].v_w, Vcur)),
-                                       d_head, n_head, N);
-                struct ggml_tensor *V = ggml_permute(ctx0, Vcur, 0, 2, 1, 3);
+void bert_encode(
+    struct bert_ctx *ctx,
+    int32_t n_threads,
+    const char *texts,
+    float *embeddings)
+{
+    bert_state_encode(ctx->state.get(), n_threads, texts, embeddings);
+}
 
-                struct ggml_tensor *KQ = ggml_mul_mat(ctx0, K, Q);
-                // KQ = soft_max(KQ / sqrt(head width))
-                KQ = ggml_soft_max(ctx0,
-                                   ggml_scale(ctx0,
-                                              KQ,
-                                              ggml_new_f32(ctx0, 1.0f / sqrt((float)d_head))));
+// Inputs of similar length share a bucket, a batch never mixes buckets
+static int32_t bert_length_bucket(int32_t n_tokens)
+{
+    int32_t bucket = 0;
+    while ((8 << bucket) < n_tokens)
+    {
+        bucket++;
+    }
+    return bucket;
+}
 
-                V = ggml_cont(ctx0, ggml_transpose(ctx0, V));
-                struct ggml_tensor *KQV = ggml_mul_mat(ctx0, V, KQ);
-                KQV = ggml_permute(ctx0, KQV, 0, 2, 1, 3);
+// Evaluates inputs sorted by length, longest first, in batches of at most n_batch_size inputs
+static void bert_eval_sorted(
+    bert_state * state,
+    int32_t n_threads,
+    int32_t n_batch_size,
+    int32_t n_inputs,
+    bert_vocab_id ** tokens,
+    int32_t * n_tokens,
+    float ** embeddings)
+{
+    const bert_ctx * ctx = state->ctx;
 
-                cur = ggml_cpy(ctx0,
-                               KQV,
-                               ggml_new_tensor_2d(ctx0, GGML_TYPE_F32, n_embd, N));
-            }
-            // attention output
-            cur = ggml_add(ctx0,
-                           ggml_repeat(ctx0, model.layers[il].o_b, cur),
-                           ggml_mul_mat(ctx0, model.layers[il].o_w, cur));
+    // padded: fill each batch from one length bucket until it runs out of inputs,
+    // reaches n_batch_size or the padded size goes over the token budget
+    // packed: inputs of any length share a batch, the budget limits the sum of tokens
+    const bool packed = ctx->batch_mode == BERT_BATCH_PACKED;
+    bert_batch_stats & stats = state->batch_stats;
+    stats = {};
+    const int64_t t_start_us = ggml_time_us();
 
-            // re-add the layer input
-            cur = ggml_add(ctx0, cur, inpL);
+    for (int i = 0; i < n_inputs;)
+    {
+        const int32_t n_longest = n_tokens[i];
+        const int32_t bucket = bert_length_bucket(n_longest);
 
-            // attention norm
+        int32_t n_batch = 1;
+        int32_t n_batch_tokens = n_longest;
+        while (i + n_batch < n_inputs && n_batch < n_batch_size)
+        {
+            const int32_t n_next = n_tokens[i + n_batch];
+            if (packed)
             {
-                cur = ggml_norm(ctx0, cur);
-
-                cur = ggml_add(ctx0,
-                               ggml_mul(ctx0,
-                                        ggml_repeat(ctx0, model.layers[il].ln_att_w, cur),
-                                        cur),
-                               ggml_repeat(ctx0, model.layers[il].ln_att_b, cur));
+                if (n_batch_tokens + n_next > ctx->max_batch_tokens ||
+                    bert_graph_mem(ctx, BERT_BATCH_PACKED, n_batch_tokens + n_next, n_batch + 1) > BERT_MAX_COMPUTE_MEM)
+                {
+                    break;
+                }
             }
-            struct ggml_tensor *att_output = cur;
-            // intermediate_output = self.intermediate(attention_output)
-            cur = ggml_mul_mat(ctx0, model.layers[il].ff_i_w, cur);
-            cur = ggml_add(ctx0,
-                           ggml_repeat(ctx0, model.layers[il].ff_i_b, cur),
-                           cur);
-            cur = ggml_gelu(ctx0, cur);
-
-            // layer_output = self.output(intermediate_output, attention_output)
-            cur = ggml_mul_mat(ctx0, model.layers[il].ff_o_w, cur);
-            cur = ggml_add(ctx0,
-                           ggml_repeat(ctx0, model.layers[il].ff_o_b, cur),
-                           cur);
-            // attentions bypass the intermediate layer
-            cur = ggml_add(ctx0, att_output, cur);
-
-            // output norm
+            else if (bert_length_bucket(n_next) != bucket ||
+                     n_longest * (n_batch + 1) > ctx->max_batch_tokens ||
+                     bert_graph_mem(ctx, BERT_BATCH_PADDED, n_longest, n_batch + 1) > BERT_MAX_COMPUTE_MEM)
             {
-                cur = ggml_norm(ctx0, cur);
-
-                cur = ggml_add(ctx0,
-                               ggml_mul(ctx0,
-                                        ggml_repeat(ctx0, model.layers[il].ln_out_w, cur),
-                                        cur),
-                               ggml_repeat(ctx0, model.layers[il].ln_out_b, cur));
-            }
-            inpL = cur;
+                break;
+            }
+            n_batch_tokens += n_next;
+            n_batch++;
         }
-        inpL = ggml_cont(ctx0, ggml_transpose(ctx0, inpL));
-        // pooler
-        struct ggml_tensor *sum = ggml_new_tensor_2d(ctx0, GGML_TYPE_F32, N, 1);
-        ggml_set_f32(sum, 1.0f / N);
-        inpL = ggml_mul_mat(ctx0, inpL, sum);
-
-        // normalizer
-        ggml_tensor *length = ggml_sqrt(ctx0,
-                                        ggml_sum(ctx0, ggml_sqr(ctx0, inpL)));
-        inpL = ggml_scale(ctx0, inpL, ggml_div(ctx0, ggml_new_f32(ctx0, 1.0f), length));
-
-        ggml_tensor *output = inpL;
-        // run the computation
-        ggml_build_forward_expand(&gf, output);
-        ggml_graph_compute_with_ctx(ctx0, &gf, n_threads);
-
-
-        // float *dat = ggml_get_data_f32(output);
-        // pretty_print_tensor(dat, output->ne, output->nb, output->n_dims - 1, "");
-
-        #ifdef GGML_PERF
-            // print timing information per ggml operation (for debugging purposes)
-            // requires GGML_PERF to be defined
-            ggml_graph_print(&gf);
-        #endif
 
-        if (!mem_req_mode) {
-            memcpy(batch_embeddings[ba], (float *)ggml_get_data(output), sizeof(float) * n_embd);
-        } else {
-            mem_per_token = ggml_used_mem(ctx0) / N;
+        bert_state_eval_batch(state, n_threads, n_batch, tokens + i, n_tokens + i, embeddings + i);
 
-            // printf("used_mem = %zu KB \n", ggml_used_mem(ctx0) / 1024);
-            // printf("mem_per_token = %zu KB \n", mem_per_token / 1024);
-        }
-
-        ggml_free(ctx0);
+        // padding counts the rows the graph was rounded up to as well
+        const int64_t n_rows = packed ? bert_graph_rows(ctx, BERT_BATCH_PACKED, n_batch_tokens)
+                                      : int64_t(bert_graph_rows(ctx, BERT_BATCH_PADDED, n_longest)) * n_batch;
+        stats.n_batches++;
+        stats.n_tokens += n_batch_tokens;
+        stats.n_padding += n_rows - n_batch_tokens;
+        i += n_batch;
     }
+    stats.t_eval_us = ggml_time_us() - t_start_us;
 }
 
-void bert_encode(
-    struct bert_ctx *ctx,
-    int32_t n_threads,
-    const char *texts,
-    float *embeddings)
-{
-    bert_encode_batch(ctx, n_threads, 1, 1, &texts, &embeddings);
-}
-
-void bert_encode_batch(
-    struct bert_ctx *ctx,
+void bert_state_encode_batch(
+    struct bert_state *state,
     int32_t n_threads,
     int32_t n_batch_size,
     int32_t n_inputs,
     const char ** texts,
     float **embeddings)
 {
-    // TODO: Disable batching for now
-    n_batch_size = 1;
-    /*
+    bert_ctx * ctx = state->ctx;
+
     if (n_batch_size > n_inputs) {
         n_batch_size = n_inputs;
     }
-    if (n_batch_size > ctx->max_batch_n) {
-        bert_resize_ctx(ctx, n_batch_size);
-        n_batch_size = ctx->max_batch_n;
+    if (n_batch_size < 1) {
+        n_batch_size = 1;
     }
-    */
-
-    int32_t N = bert_n_max_tokens(ctx);
 
+    const int64_t t_start_us = ggml_time_us();
     std::vector<bert_vocab_id> buf_tokens;
-    // Most of this buffer will be unused in typical case where inputs are not that long.
-    buf_tokens.resize(N * n_inputs);
+    std::vector<int64_t> offsets;
+    bert_tokenize_csr(state, n_threads, n_inputs, texts, bert_n_max_tokens(ctx), buf_tokens, offsets);
+    const int64_t t_tokenize_us = ggml_time_us() - t_start_us;
+
     std::vector<int32_t> n_tokens = std::vector<int32_t>(n_inputs);
     std::vector<bert_vocab_id*> unsorted_tokens(n_inputs);
-    bert_vocab_id* it_tokens = buf_tokens.data();
     for (int i = 0; i < n_inputs; i++) {
-        unsorted_tokens[i] = it_tokens;
-        bert_tokenize(ctx, texts[i], it_tokens, &n_tokens[i], N);
-        it_tokens += n_tokens[i];
+        unsorted_tokens[i] = buf_tokens.data() + offsets[i];
+        n_tokens[i] = offsets[i + 1] - offsets[i];
     }
 
-    if (n_batch_size == n_inputs) {
-        bert_eval_batch(ctx, n_threads, n_batch_size, unsorted_tokens.data(), n_tokens.data(), embeddings);
-    } else {
-        // sort the inputs by tokenized length, batch and eval
-
-        std::vector<int> indices;
-        indices.reserve(n_inputs);
+    // inputs found in the embedding cache or store are copied and not evaluated,
+    // inputs with the same tokens as an earlier one are evaluated once
+    bert_embedding_cache * cache = ctx->embedding_cache.get();
+    bert_embedding_store * store = ctx->embedding_store.get();
+    std::vector<uint64_t> hashes;
+    std::vector<std::pair<int, int>> duplicates; // (input, earlier input with the same tokens)
+    std::vector<int> indices;
+    indices.reserve(n_inputs);
+    if (cache || store)
+    {
+        hashes.resize(n_inputs);
+        std::unordered_map<uint64_t, int> first;
+        for (int i = 0; i < n_inputs; i++)
+        {
+            hashes[i] = bert_embedding_cache::hash(unsorted_tokens[i], n_tokens[i]);
+            if (cache && cache->lookup(unsorted_tokens[i], n_tokens[i], hashes[i], embeddings[i]))
+            {
+                continue;
+            }
+            if (store && store->lookup(unsorted_tokens[i], n_tokens[i], hashes[i], embeddings[i]))
+            {
+                if (cache)
+                {
+                    cache->insert(unsorted_tokens[i], n_tokens[i], hashes[i], embeddings[i], ctx->model.hparams.n_embd);
+                }
+                continue;
+            }
+            auto res = first.emplace(hashes[i], i);
+            const int j = res.first->second;
+            if (!res.second && std::equal(unsorted_tokens[i], unsorted_tokens[i] + n_tokens[i], unsorted_tokens[j], unsorted_tokens[j] + n_tokens[j]))
+            {
+                duplicates.emplace_back(i, j);
+                continue;
+            }
+            indices.push_back(i);
+        }
+    }
+    else
+    {
         for (int i = 0; i < n_inputs; i++)
         {
             indices.push_back(i);
         }
+    }
+    const int n_eval = indices.size();
 
-        std::vector<int32_t> sorted_n_tokens = std::vector<int32_t>(n_inputs);
+    // sort the inputs by tokenized length, longest first
+    std::stable_sort(indices.begin(), indices.end(), [&](int a, int b)
+                     { return n_tokens[a] > n_tokens[b]; });
 
-        std::vector<bert_vocab_id *> sorted_tokens(n_inputs);
+    std::vector<int32_t> sorted_n_tokens(n_eval);
+    std::vector<bert_vocab_id *> sorted_tokens(n_eval);
+    std::vector<float *> sorted_embeddings(n_eval);
 
-        std::sort(indices.begin(), indices.end(), [&](int a, int b)
-                  { return n_tokens[a] < n_tokens[b]; });
+    for (int i = 0; i < n_eval; i++) {
+        sorted_embeddings[i] = embeddings[indices[i]];
+        sorted_tokens[i] = unsorted_tokens[indices[i]];
+        sorted_n_tokens[i] = n_tokens[indices[i]];
+    }
 
-        std::vector<float *> sorted_embeddings(n_inputs);
-        memcpy(sorted_embeddings.data(), embeddings, n_inputs * sizeof(float *));
+    bert_eval_sorted(state, n_threads, n_batch_size, n_eval, sorted_tokens.data(), sorted_n_tokens.data(), sorted_embeddings.data());
+    state->batch_stats.t_tokenize_us = t_tokenize_us;
 
-        for (int i = 0; i < n_inputs; i++) {
-            sorted_embeddings[i] = embeddings[indices[i]];
-            sorted_tokens[i] = unsorted_tokens[indices[i]];
-            sorted_n_tokens[i] = n_tokens[indices[i]];
+    if (cache || store)
+    {
+        const int n_embd = ctx->model.hparams.n_embd;
+        if (cache)
+        {
+            for (int i : indices)
+            {
+                cache->insert(unsorted_tokens[i], n_tokens[i], hashes[i], embeddings[i], n_embd);
+            }
         }
-
-        for (int i = 0; i < n_inputs; i += n_batch_size)
+        if (store && n_eval > 0)
         {
-            if (i + n_batch_size > n_inputs) {
-                n_batch_size = n_inputs - i;
+            std::vector<uint64_t> sorted_hashes(n_eval);
+            for (int i = 0; i < n_eval; i++)
+            {
+                sorted_hashes[i] = hashes[indices[i]];
             }
-            bert_eval_batch(ctx, n_threads, n_batch_size, &sorted_tokens[i], &sorted_n_tokens[i], &sorted_embeddings[i]);
+            store->append(n_eval, sorted_tokens.data(), sorted_n_tokens.data(), sorted_hashes.data(), sorted_embeddings.data());
+        }
+        for (auto [i, j] : duplicates)
+        {
+            std::copy(embeddings[j], embeddings[j] + n_embd, embeddings[i]);
+        }
+    }
+}
+
+void bert_encode_batch(
+    struct bert_ctx *ctx,
+    int32_t n_threads,
+    int32_t n_batch_size,
+    int32_t n_inputs,
+    const char ** texts,
+    float **embeddings)
+{
+    bert_state_encode_batch(ctx->state.get(), n_threads, n_batch_size, n_inputs, texts, embeddings);
+}
+
+int32_t bert_state_encode_long(
+    struct bert_state * state,
+    int32_t n_threads,
+    const char * text,
+    struct bert_long_params params,
+    float * embedding,
+    float * chunk_embeddings,
+    int32_t n_max_chunks)
+{
+    bert_ctx * ctx = state->ctx;
+    const int32_t n_embd = ctx->model.hparams.n_embd;
+    const int32_t n_max_tokens = ctx->model.hparams.n_max_tokens;
+
+    // tokens of a window without [CLS] and [SEP]
+    const int32_t n_window = params.n_window > 0 ? std::min(params.n_window, n_max_tokens) : n_max_tokens;
+    const int32_t n_content = std::max(n_window - 2, 1);
+    const int32_t n_stride = params.n_stride > 0 ? std::min(params.n_stride, n_content) : std::max(n_content / 2, 1);
+
+    // tokenize the whole text, every token takes at least one byte so the buffer only grows
+    // if normalization made the text longer
+    const int64_t t_start_us = ggml_time_us();
+    std::vector<bert_vocab_id> doc(strlen(text) + 3);
+    int32_t n_doc = 0;
+    for (;;)
+    {
+        bert_tokenize(ctx, text, doc.data(), &n_doc, doc.size());
+        if (n_doc < (int32_t) doc.size())
+        {
+            break;
+        }
+        doc.resize(doc.size() * 2);
+    }
+    const int64_t t_tokenize_us = ggml_time_us() - t_start_us;
+    const bert_vocab_id cls_tok_id = doc[0];
+    const bert_vocab_id sep_tok_id = doc[n_doc - 1];
+    const int32_t n_text = n_doc - 2;
+
+    std::vector<int32_t> starts;
+    for (int32_t start = 0;; start += n_stride)
+    {
+        starts.push_back(start);
+        if (start + n_content >= n_text)
+        {
+            break;
+        }
+    }
+    const int32_t n_windows = starts.size();
+
+    // only the last window can be shorter, so the windows are already sorted longest first
+    std::vector<bert_vocab_id> window_tokens(size_t(n_windows) * (n_content + 2));
+    std::vector<float> window_embeddings(size_t(n_windows) * n_embd);
+    std::vector<bert_vocab_id *> batch_tokens(n_windows);
+    std::vector<int32_t> n_tokens(n_windows);
+    std::vector<float *> batch_embeddings(n_windows);
+    for (int32_t w = 0; w < n_windows; w++)
+    {
+        const int32_t n = std::min(n_content, n_text - starts[w]);
+        bert_vocab_id * out = window_tokens.data() + size_t(w) * (n_content + 2);
+        out[0] = cls_tok_id;
+        std::copy(doc.begin() + 1 + starts[w], doc.begin() + 1 + starts[w] + n, out + 1);
+        out[n + 1] = sep_tok_id;
+
+        batch_tokens[w] = out;
+        n_tokens[w] = n + 2;
+        batch_embeddings[w] = window_embeddings.data() + size_t(w) * n_embd;
+    }
+
+    bert_eval_sorted(state, n_threads, n_windows, n_windows, batch_tokens.data(), n_tokens.data(), batch_embeddings.data());
+    state->batch_stats.t_tokenize_us = t_tokenize_us;
+
+    std::vector<double> sum(n_embd, 0.0);
+    for (int32_t w = 0; w < n_windows; w++)
+    {
+        const double weight = params.combine == BERT_COMBINE_WEIGHTED ? std::max(n_tokens[w] - 2, 1) : 1;
+        for (int i = 0; i < n_embd; i++)
+        {
+            sum[i] += weight * batch_embeddings[w][i];
         }
     }
+
+    // normalizer
+    double length = 0.0;
+    for (int i = 0; i < n_embd; i++)
+    {
+        length += sum[i] * sum[i];
+    }
+    const double scale = length > 0.0 ? 1.0 / sqrt(length) : 0.0;
+    for (int i = 0; i < n_embd; i++)
+    {
+        embedding[i] = sum[i] * scale;
+    }
+
+    if (chunk_embeddings)
+    {
+        const int32_t n_chunks = std::min(n_windows, n_max_chunks);
+        std::copy(window_embeddings.begin(), window_embeddings.begin() + size_t(std::max(n_chunks, 0)) * n_embd, chunk_embeddings);
+    }
+    return n_windows;
+}
+
+int32_t bert_encode_long(
+    struct bert_ctx * ctx,
+    int32_t n_threads,
+    const char * text,
+    struct bert_long_params params,
+    float * embedding,
+    float * chunk_embeddings,
+    int32_t n_max_chunks)
+{
+    return bert_state_encode_long(ctx->state.get(), n_threads, text, params, embedding, chunk_embeddings, n_max_chunks);
 }
@@ -19,6 +19,12 @@ struct bert_params
 {
     int32_t n_threads = 6;
     int32_t port = 8080; // server mode port to bind
+    int32_t n_workers = 1; // server mode eval workers, they share the threads
+    int32_t n_batch_size = 32; // server mode max texts per batch
+    int32_t batch_wait_us = 2000; // server mode max time a request waits for a batch to fill
+    int32_t n_max_queue = 1024; // server mode max texts waiting per priority
+    int32_t metrics_port = 0; // server mode port of the metrics endpoint, 0 disables it
+    int32_t embedding_cache_mb = 0; // server mode size of the embedding cache
 
     const char* model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin"; // model path
     const char* prompt = "test prompt";
@@ -30,7 +36,86 @@ struct bert_ctx;
 
 typedef int32_t bert_vocab_id;
 
+enum bert_batch_mode
+{
+    BERT_BATCH_PADDED = 0,  // inputs are padded to the longest one in the batch
+    BERT_BATCH_PACKED = 1,  // inputs are concatenated, attention is computed per input
+};
+
+// Batching statistics of a bert_encode_batch call
+struct bert_batch_stats
+{
+    int32_t n_batches = 0;  // number of evaluated batches
+    int64_t n_tokens = 0;   // real tokens evaluated
+    int64_t n_padding = 0;  // padding tokens evaluated
+    int64_t t_tokenize_us = 0; // time spent tokenizing
+    int64_t t_eval_us = 0;  // time spent evaluating the batches
+};
+
+// Counters of the compute graph cache, graphs are cached per batch shape
+struct bert_graph_cache_stats
+{
+    int64_t n_hits = 0;     // evals that reused a cached graph
+    int64_t n_misses = 0;   // evals that had to build a new graph
+    int32_t n_graphs = 0;   // graphs currently cached
+    int64_t mem_size = 0;   // bytes of compute buffers held by the cached graphs
+    int64_t last_mem_size = 0; // bytes of compute buffer of the graph used by the last eval
+};
+
+// Counters of the word cache, see bert_set_word_cache_size
+struct bert_word_cache_stats
+{
+    int64_t n_hits = 0;       // words found in the cache
+    int64_t n_misses = 0;     // words that had to be matched against the vocab
+    int64_t n_words = 0;      // words currently cached
+    int64_t mem_size = 0;     // approximate bytes used by the cached words
+    int64_t max_mem_size = 0;
+};
+
+// Counters of the embedding cache, see bert_set_embedding_cache_size
+struct bert_embedding_cache_stats
+{
+    int64_t n_hits = 0;       // inputs whose embedding was found in the cache
+    int64_t n_misses = 0;     // inputs that had to be evaluated
+    int64_t n_evictions = 0;  // entries dropped to make room for new ones
+    int64_t n_entries = 0;    // embeddings currently cached
+    int64_t mem_size = 0;     // approximate bytes used by the cached embeddings
+    int64_t max_mem_size = 0;
+};
+
+// Counters of the embedding store, see bert_set_embedding_store
+struct bert_embedding_store_stats
+{
+    int64_t n_hits = 0;     // inputs whose embedding was read from the store
+    int64_t n_misses = 0;   // inputs that weren't in the store
+    int64_t n_appends = 0;  // embeddings this context appended
+    int64_t n_records = 0;  // embeddings of this model in the store
+    int64_t size = 0;       // bytes of the store file in use
+    int64_t max_size = 0;   // capacity of the store file
+};
+
+struct bert_load_params
+{
+    bool use_mmap = true;   // map the weights from the file instead of reading them, if supported
+    bool prefetch = false;  // read the whole mapping into the page cache up front
+};
+
+enum bert_long_combine
+{
+    BERT_COMBINE_MEAN = 0,      // every window counts the same
+    BERT_COMBINE_WEIGHTED = 1,  // windows are weighted by their number of tokens
+};
+
+// Windows of bert_encode_long
+struct bert_long_params
+{
+    int32_t n_window = 0;   // tokens per window including [CLS] and [SEP], 0 for bert_n_max_tokens
+    int32_t n_stride = 0;   // tokens between the starts of consecutive windows, 0 for half a window
+    enum bert_long_combine combine = BERT_COMBINE_MEAN;
+};
+
 BERT_API struct bert_ctx * bert_load_from_file(const char * fname);
+BERT_API struct bert_ctx * bert_load_from_file_with_params(const char * fname, struct bert_load_params params);
 BERT_API void bert_free(bert_ctx * ctx);
 
 // Main api, does both tokenizing and evaluation
@@ -41,7 +126,8 @@ BERT_API void bert_encode(
     const char * texts,
     float * embeddings);
 
-// n_batch_size - how many to process at a time
+// Inputs are sorted by length and batched with inputs of similar length
+// n_batch_size - max number of inputs to process at a time
 // n_inputs     - total size of texts and embeddings arrays
 BERT_API void bert_encode_batch(
     struct bert_ctx * ctx,
@@ -51,6 +137,64 @@ BERT_API void bert_encode_batch(
     const char ** texts,
     float ** embeddings);
 
+// Encodes a text of any length. The tokens are split into overlapping windows, the windows are
+// evaluated in as few batches as the token budget allows and their embeddings are combined into one.
+// chunk_embeddings (optional) receives the embeddings of the first n_max_chunks windows, n_embd floats each.
+// Returns the number of windows.
+BERT_API int32_t bert_encode_long(
+    struct bert_ctx * ctx,
+    int32_t n_threads,
+    const char * text,
+    struct bert_long_params params,
+    float * embedding,
+    float * chunk_embeddings,
+    int32_t n_max_chunks);
+
+// Token budget of one batch in bert_encode_batch
+// (longest input * batch size when padded, sum of input lengths when packed)
+BERT_API void bert_set_max_batch_tokens(bert_ctx * ctx, int32_t n_max_batch_tokens);
+
+// How bert_eval_batch lays out the batch, BERT_BATCH_PADDED by default
+BERT_API void bert_set_batch_mode(bert_ctx * ctx, enum bert_batch_mode mode);
+
+// Attention without materializing the attention scores, enabled by default.
+// Packed batches always use fused attention.
+BERT_API void bert_set_fused_attention(bert_ctx * ctx, bool fused);
+
+// Every state keeps worker threads that tokenize batches of more than 64 texts, graph evaluation runs on
+// the threads of ggml. Idle workers spin for spin_us microseconds before they sleep, 0 by default so they
+// don't compete with ggml's threads. pin_threads pins each worker to its own core (Linux only).
+// States pick up new params on their next batch.
+BERT_API void bert_set_threadpool_params(bert_ctx * ctx, int32_t spin_us, bool pin_threads);
+
+// Cache of normalized words and their tokens, used by all tokenization with the context.
+// Disabled by default, max_mem_size 0 disables it again. Clears the cache.
+BERT_API void bert_set_word_cache_size(bert_ctx * ctx, size_t max_mem_size);
+
+BERT_API struct bert_word_cache_stats bert_get_word_cache_stats(bert_ctx * ctx);
+
+// Cache of the embeddings computed by bert_encode and bert_encode_batch, keyed by the tokens of the input.
+// Cached inputs aren't evaluated again, the least recently used are evicted to stay under max_mem_size.
+// Disabled by default, max_mem_size 0 disables it again. Clears the cache.
+BERT_API void bert_set_embedding_cache_size(bert_ctx * ctx, size_t max_mem_size);
+
+BERT_API struct bert_embedding_cache_stats bert_get_embedding_cache_stats(bert_ctx * ctx);
+
+// Embedding store file at path, shared by all processes that open it. bert_encode and bert_encode_batch
+// read the embeddings of inputs from it and append the ones they compute, keyed by a hash of the
+// model as it was loaded and the tokens of the input. A new file gets a capacity of max_size bytes, appends stop
+// once it is full. Checked after the embedding cache. path NULL closes the store. The first store
+// set on a context hashes the model, which reads every weight.
+// Returns false if the file can't be opened or isn't an embedding store.
+BERT_API bool bert_set_embedding_store(bert_ctx * ctx, const char * path, size_t max_size);
+
+BERT_API struct bert_embedding_store_stats bert_get_embedding_store_stats(bert_ctx * ctx);
+
+// Batching statistics of the last bert_encode_batch call
+BERT_API struct bert_batch_stats bert_get_batch_stats(bert_ctx * ctx);
+
+BERT_API struct bert_graph_cache_stats bert_get_graph_cache_stats(bert_ctx * ctx);
+
 // Api for separate tokenization & eval
 
 BERT_API void bert_tokenize(
@@ -60,6 +204,25 @@ BERT_API void bert_tokenize(
     int32_t * n_tokens,
     int32_t n_max_tokens);
 
+// Tokens of several texts in one buffer, the tokens of text i are tokens[offsets[i]] .. tokens[offsets[i + 1] - 1]
+struct bert_tokens
+{
+    bert_vocab_id * tokens;
+    int64_t * offsets;      // n_inputs + 1 entries
+    int32_t n_inputs;
+};
+
+// Tokenizes the texts on n_threads threads, each text to at most n_max_tokens tokens.
+// The result is freed with bert_tokens_free. If it can't be allocated, tokens is NULL and n_inputs 0.
+BERT_API struct bert_tokens bert_tokenize_batch(
+    struct bert_ctx * ctx,
+    int32_t n_threads,
+    int32_t n_inputs,
+    const char ** texts,
+    int32_t n_max_tokens);
+
+BERT_API void bert_tokens_free(struct bert_tokens tokens);
+
 BERT_API void bert_eval(
     struct bert_ctx * ctx,
     int32_t n_threads,
@@ -67,7 +230,7 @@ BERT_API void bert_eval(
     int32_t n_tokens,
     float * embeddings);
 
-// NOTE: for batch processing the longest input must be first
+// Evaluates the whole batch as one graph, see bert_set_batch_mode for the layout
 BERT_API void bert_eval_batch(
     struct bert_ctx * ctx,
     int32_t n_threads,
@@ -77,10 +240,65 @@ BERT_API void bert_eval_batch(
     float ** batch_embeddings);
 
 BERT_API int32_t bert_n_embd(bert_ctx * ctx);
+BERT_API int32_t bert_n_vocab(bert_ctx * ctx);
 BERT_API int32_t bert_n_max_tokens(bert_ctx * ctx);
 
 BERT_API const char* bert_vocab_id_to_token(bert_ctx * ctx, bert_vocab_id id);
 
+// Api for sharing one model between threads
+//
+// The calls above that take a bert_ctx evaluate on a state owned by the context and must not be
+// called from more than one thread at a time. Each thread can instead evaluate on its own
+// bert_state, the states only read the weights of the context. The settings of the context
+// are read by every eval and should not be changed while states are in use.
+// Free all states of a context before the context itself.
+
+struct bert_state;
+
+BERT_API struct bert_state * bert_state_new(struct bert_ctx * ctx);
+BERT_API void bert_state_free(struct bert_state * state);
+
+BERT_API void bert_state_encode(
+    struct bert_state * state,
+    int32_t n_threads,
+    const char * texts,
+    float * embeddings);
+
+BERT_API void bert_state_encode_batch(
+    struct bert_state * state,
+    int32_t n_threads,
+    int32_t n_batch_size,
+    int32_t n_inputs,
+    const char ** texts,
+    float ** embeddings);
+
+BERT_API int32_t bert_state_encode_long(
+    struct bert_state * state,
+    int32_t n_threads,
+    const char * text,
+    struct bert_long_params params,
+    float * embedding,
+    float * chunk_embeddings,
+    int32_t n_max_chunks);
+
+BERT_API struct bert_tokens bert_state_tokenize_batch(
+    struct bert_state * state,
+    int32_t n_threads,
+    int32_t n_inputs,
+    const char ** texts,
+    int32_t n_max_tokens);
+
+BERT_API void bert_state_eval_batch(
+    struct bert_state * state,
+    int32_t n_threads,
+    int32_t n_batch_size,
+    bert_vocab_id ** batch_tokens,
+    int32_t * n_tokens,
+    float ** batch_embeddings);
+
+BERT_API struct bert_batch_stats bert_state_get_batch_stats(struct bert_state * state);
+BERT_API struct bert_graph_cache_stats bert_state_get_graph_cache_stats(struct bert_state * state);
+
 #ifdef __cplusplus
 }
 #endif
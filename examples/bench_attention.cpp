@@ -0,0 +1,78 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <vector>
+
+// Compares fused attention with the attention that materializes the scores
+// on batches of equally long inputs.
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-f16.bin";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    bert_ctx * bctx;
+
+    // load the model
+    {
+        if ((bctx = bert_load_from_file(params.model)) == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+    }
+
+    const int n_batch = 4;
+    const int n_iter = 5;
+    const int n_embd = bert_n_embd(bctx);
+    const int lengths[] = {128, 256, 512};
+
+    std::vector<float> embeddings(n_batch * n_embd);
+    std::vector<float *> batch_embeddings(n_batch);
+    for (int i = 0; i < n_batch; i++) {
+        batch_embeddings[i] = embeddings.data() + i * n_embd;
+    }
+
+    printf("\n%6s %6s %8s %12s %12s\n", "N", "batch", "fused", "eval ms", "buffer MB");
+    for (int N : lengths) {
+        if (N > bert_n_max_tokens(bctx)) {
+            continue;
+        }
+
+        // [CLS] tokens... [SEP]
+        std::vector<bert_vocab_id> tokens(N);
+        for (int i = 0; i < N; i++) {
+            tokens[i] = 1000 + i % 1000;
+        }
+        tokens[0] = 101;
+        tokens[N - 1] = 102;
+        std::vector<bert_vocab_id *> batch_tokens(n_batch, tokens.data());
+        std::vector<int32_t> n_tokens(n_batch, N);
+
+        for (bool fused : {false, true}) {
+            bert_set_fused_attention(bctx, fused);
+
+            // first eval builds the graph
+            bert_eval_batch(bctx, params.n_threads, n_batch, batch_tokens.data(), n_tokens.data(), batch_embeddings.data());
+            const int64_t mem_size = bert_get_graph_cache_stats(bctx).last_mem_size;
+
+            const int64_t t_start_us = ggml_time_us();
+            for (int it = 0; it < n_iter; it++) {
+                bert_eval_batch(bctx, params.n_threads, n_batch, batch_tokens.data(), n_tokens.data(), batch_embeddings.data());
+            }
+            const int64_t t_eval_us = (ggml_time_us() - t_start_us) / n_iter;
+
+            printf("%6d %6d %8s %12.2f %12.2f\n", N, n_batch, fused ? "yes" : "no", t_eval_us / 1000.0f, mem_size / 1024.0f / 1024.0f);
+        }
+    }
+
+    bert_free(bctx);
+
+    return 0;
+}
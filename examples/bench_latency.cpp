@@ -0,0 +1,93 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Latency percentiles of bert_encode for a single short input, and of bert_tokenize_batch on one
+// thread (how batches were tokenized before the worker pool) against the pool with and without spinning
+
+// p50, p99 and max in ms of n_iter runs of fn
+static void bench_percentiles(int n_iter, const std::function<void()> & fn, float * p50, float * p99, float * max) {
+    std::vector<int64_t> t_us(n_iter);
+    fn();
+    for (int it = 0; it < n_iter; it++) {
+        const int64_t t_start_us = ggml_time_us();
+        fn();
+        t_us[it] = ggml_time_us() - t_start_us;
+    }
+    std::sort(t_us.begin(), t_us.end());
+    *p50 = t_us[n_iter / 2] / 1000.0f;
+    *p99 = t_us[n_iter * 99 / 100] / 1000.0f;
+    *max = t_us[n_iter - 1] / 1000.0f;
+}
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+    params.prompt = "cheap flights to helsinki";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    bert_ctx * bctx;
+
+    // load the model
+    {
+        if ((bctx = bert_load_from_file(params.model)) == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+    }
+
+    const int n_iter = 500;
+    std::vector<float> embeddings(bert_n_embd(bctx));
+    float p50, p99, max;
+
+    // bert_encode evaluates on ggml's threads, the worker pool isn't involved
+    printf("\nbert_encode\n%8s %10s %10s %10s\n", "threads", "p50 ms", "p99 ms", "max ms");
+    for (int n_threads = 1; n_threads <= params.n_threads; n_threads *= 2) {
+        bench_percentiles(n_iter, [&] { bert_encode(bctx, n_threads, params.prompt, embeddings.data()); }, &p50, &p99, &max);
+        printf("%8d %10.3f %10.3f %10.3f\n", n_threads, p50, p99, max);
+    }
+
+    // batches of more than 64 texts are tokenized on the pool, smaller ones on the calling thread
+    const int N = bert_n_max_tokens(bctx);
+    const std::string prompt = params.prompt;
+    printf("\nbert_tokenize_batch on %d threads, speedup over one thread\n", params.n_threads);
+    printf("%8s %-24s %10s %10s %10s %8s\n", "texts", "", "p50 ms", "p99 ms", "max ms", "speedup");
+    for (int n_texts : { 16, 256, 1024 }) {
+        std::vector<std::string> texts(n_texts);
+        std::vector<const char *> text_ptrs(n_texts);
+        for (int i = 0; i < n_texts; i++) {
+            texts[i] = prompt + " " + std::to_string(i);
+            text_ptrs[i] = texts[i].c_str();
+        }
+        float p50_serial = 0.0f;
+        for (int run = 0; run < 3; run++) {
+            const int n_threads = run == 0 ? 1 : params.n_threads;
+            bert_set_threadpool_params(bctx, run == 2 ? 1000 : 0, false);
+            bench_percentiles(n_iter / 5, [&] {
+                bert_tokens result = bert_tokenize_batch(bctx, n_threads, n_texts, text_ptrs.data(), N);
+                bert_tokens_free(result);
+            }, &p50, &p99, &max);
+            if (run == 0) {
+                p50_serial = p50;
+            }
+            const char * label = run == 0 ? "one thread (before)" : run == 1 ? "pool" : "pool, 1 ms spin";
+            printf("%8d %-24s %10.3f %10.3f %10.3f %7.2fx\n", n_texts, label, p50, p99, max, p50_serial / p50);
+        }
+    }
+    bert_set_threadpool_params(bctx, 0, false);
+
+    bert_free(bctx);
+
+    return 0;
+}
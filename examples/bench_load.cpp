@@ -0,0 +1,95 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <vector>
+
+// Load time and memory of reading the model vs mapping it.
+// Run it once per mode for cold page cache numbers, e.g. after dropping the caches.
+
+// Resident and shared (file backed) memory of the process in MB, Linux only
+static bool get_rss(double & rss, double & shared) {
+    FILE * f = fopen("/proc/self/statm", "r");
+    if (!f) {
+        return false;
+    }
+    long size = 0, resident = 0, share = 0;
+    const bool ok = fscanf(f, "%ld %ld %ld", &size, &resident, &share) == 3;
+    fclose(f);
+    const double page_mb = sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+    rss = resident * page_mb;
+    shared = share * page_mb;
+    return ok;
+}
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    struct mode {
+        const char * name;
+        bool use_mmap;
+        bool prefetch;
+    };
+    const mode modes[] = {
+        { "read",          false, false },
+        { "mmap",          true,  false },
+        { "mmap+prefetch", true,  true  },
+    };
+
+    struct result {
+        double t_load_ms;
+        double rss_load, shared_load;
+        double rss_eval, shared_eval;
+    };
+    std::vector<result> results;
+
+    for (const auto & m : modes) {
+        bert_load_params load_params;
+        load_params.use_mmap = m.use_mmap;
+        load_params.prefetch = m.prefetch;
+
+        double rss_base = 0, shared_base = 0;
+        get_rss(rss_base, shared_base);
+
+        const int64_t t_start_us = ggml_time_us();
+        bert_ctx * bctx = bert_load_from_file_with_params(params.model, load_params);
+        if (bctx == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+
+        result r = {};
+        r.t_load_ms = (ggml_time_us() - t_start_us) / 1000.0;
+        get_rss(r.rss_load, r.shared_load);
+
+        // touches all of the weights
+        std::vector<float> embeddings(bert_n_embd(bctx));
+        bert_encode(bctx, params.n_threads, params.prompt, embeddings.data());
+        get_rss(r.rss_eval, r.shared_eval);
+
+        r.rss_load -= rss_base;
+        r.shared_load -= shared_base;
+        r.rss_eval -= rss_base;
+        r.shared_eval -= shared_base;
+        results.push_back(r);
+
+        bert_free(bctx);
+    }
+
+    printf("\n%-14s %10s %12s %12s %12s %12s\n", "mode", "load ms", "rss MB", "private MB", "rss eval MB", "private eval");
+    for (size_t i = 0; i < results.size(); i++) {
+        const result & r = results[i];
+        printf("%-14s %10.2f %12.2f %12.2f %12.2f %12.2f\n", modes[i].name, r.t_load_ms,
+               r.rss_load, r.rss_load - r.shared_load, r.rss_eval, r.rss_eval - r.shared_eval);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Long document encoding, bert_encode_long against evaluating the same windows one at a time
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+    params.prompt = "examples/sample_client_texts.txt";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    bert_ctx * bctx;
+
+    // load the model
+    {
+        if ((bctx = bert_load_from_file(params.model)) == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+    }
+
+    // the prompt is the path of a file, its lines are joined into one document
+    std::string text;
+    {
+        std::ifstream fin(params.prompt);
+        if (!fin) {
+            fprintf(stderr, "%s: failed to open '%s'\n", __func__, params.prompt);
+            return 1;
+        }
+        std::string line;
+        while (std::getline(fin, line)) {
+            text += line;
+            text += ' ';
+        }
+    }
+
+    const int n_embd = bert_n_embd(bctx);
+    const int N = bert_n_max_tokens(bctx);
+
+    printf("\n%-10s %8s %8s %14s %14s %10s\n", "tokens", "windows", "batches", "long (ms)", "serial (ms)", "cosine");
+    for (int n_target : {1000, 2500, 5000, 10000}) {
+        // repeat the file until the document has n_target tokens
+        std::string doc;
+        std::vector<bert_vocab_id> tokens;
+        int32_t n_tokens = 0;
+        while (n_tokens < n_target) {
+            doc += text;
+            tokens.resize(doc.size() + 3);
+            bert_tokenize(bctx, doc.c_str(), tokens.data(), &n_tokens, tokens.size());
+        }
+
+        bert_long_params long_params;
+        std::vector<float> embedding(n_embd);
+        int64_t t_start_us = ggml_time_us();
+        const int32_t n_windows = bert_encode_long(bctx, params.n_threads, doc.c_str(), long_params, embedding.data(), nullptr, 0);
+        const double t_long_ms = (ggml_time_us() - t_start_us) / 1000.0;
+        const bert_batch_stats stats = bert_get_batch_stats(bctx);
+
+        // the same windows as bert_encode_long with the default params, evaluated one by one
+        const int n_content = N - 2;
+        const int n_stride = n_content / 2;
+        const int n_text = n_tokens - 2;
+        std::vector<double> sum(n_embd, 0.0);
+        std::vector<bert_vocab_id> window(N);
+        std::vector<float> window_embedding(n_embd);
+        t_start_us = ggml_time_us();
+        for (int start = 0;; start += n_stride) {
+            const int n = std::min(n_content, n_text - start);
+            window[0] = tokens[0];
+            std::copy(tokens.begin() + 1 + start, tokens.begin() + 1 + start + n, window.begin() + 1);
+            window[n + 1] = tokens[n_tokens - 1];
+            bert_eval(bctx, params.n_threads, window.data(), n + 2, window_embedding.data());
+            for (int i = 0; i < n_embd; i++) {
+                sum[i] += window_embedding[i];
+            }
+            if (start + n_content >= n_text) {
+                break;
+            }
+        }
+        const double t_serial_ms = (ggml_time_us() - t_start_us) / 1000.0;
+
+        double dot = 0.0, length = 0.0;
+        for (int i = 0; i < n_embd; i++) {
+            dot += sum[i] * embedding[i];
+            length += sum[i] * sum[i];
+        }
+
+        printf("%-10d %8d %8d %14.1f %14.1f %10.6f\n", n_tokens, n_windows, stats.n_batches,
+               t_long_ms, t_serial_ms, dot / sqrt(length));
+    }
+    printf("%d threads, windows of %d tokens\n", params.n_threads, N);
+
+    bert_free(bctx);
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Tokenizer throughput on a file of texts, one per line, against the original tokenizer as a baseline
+
+// The original tokenizer: accent map, std::regex word split and a map lookup per candidate token length
+struct baseline_tokenizer {
+    std::map<std::string, bert_vocab_id> token_to_id;
+    std::map<std::string, bert_vocab_id> subword_token_to_id;
+    std::map<std::string, char> accent_map = {{"À", 'A'},{"Á", 'A'},
+        {"Â", 'A'},{"Ã", 'A'},{"Ä", 'A'},{"Å", 'A'},{"à", 'a'},{"á", 'a'},
+        {"â", 'a'},{"ã", 'a'},{"ä", 'a'},{"å", 'a'},{"È", 'E'},{"É", 'E'},
+        {"Ê", 'E'},{"Ë", 'E'},{"è", 'e'},{"é", 'e'},{"ê", 'e'},{"ë", 'e'},
+        {"Ì", 'I'},{"Í", 'I'},{"Î", 'I'},{"Ï", 'I'},{"ì", 'i'},{"í", 'i'},
+        {"î", 'i'},{"ï", 'i'},{"Ò", 'O'},{"Ó", 'O'},{"Ô", 'O'},{"Õ", 'O'},
+        {"Ö", 'O'},{"ò", 'o'},{"ó", 'o'},{"ô", 'o'},{"õ", 'o'},{"ö", 'o'},
+        {"Ù", 'U'},{"Ú", 'U'},{"Û", 'U'},{"Ü", 'U'},{"ù", 'u'},{"ú", 'u'},
+        {"û", 'u'},{"ü", 'u'},{"Ý", 'Y'},{"ý", 'y'},{"Ç", 'C'},{"ç", 'c'},
+        {"Ñ", 'N'},{"ñ", 'n'},
+    };
+
+    explicit baseline_tokenizer(bert_ctx * bctx) {
+        for (int i = 0; i < bert_n_vocab(bctx); i++) {
+            const std::string word = bert_vocab_id_to_token(bctx, i);
+            if (word[0] == '#' && word[1] == '#') {
+                subword_token_to_id[word.substr(2)] = i;
+            }
+            if (token_to_id.count(word) == 0) {
+                token_to_id[word] = i;
+            }
+        }
+    }
+
+    static size_t utf8_len(char src) {
+        const size_t lookup[] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 4};
+        return lookup[static_cast<uint8_t>(src) >> 4];
+    }
+
+    std::string normalize(const std::string & text) const {
+        std::string result;
+        for (size_t i = 0; i < text.length();) {
+            const size_t len = utf8_len(text[i]);
+            const std::string cur = text.substr(i, len);
+            auto it = accent_map.find(cur);
+            if (it != accent_map.end()) {
+                result += it->second;
+            } else {
+                result += cur;
+            }
+            i += len;
+        }
+        for (size_t i = 0; i < result.size(); i += utf8_len(result[i])) {
+            if (result[i] >= 'A' && result[i] <= 'Z') {
+                result[i] = result[i] - 'A' + 'a';
+            }
+        }
+        return result;
+    }
+
+    void tokenize(const char * text, bert_vocab_id * tokens, int32_t * n_tokens, int32_t n_max_tokens) const {
+        std::string str = normalize(text);
+        std::vector<std::string> words;
+        std::regex re(R"([[:punct:]]|[[:alpha:]]+|[[:digit:]]+)");
+        std::smatch m;
+        while (std::regex_search(str, m, re)) {
+            for (std::string x : m) {
+                words.push_back(x);
+            }
+            str = m.suffix();
+        }
+
+        int32_t t = 0;
+        tokens[t++] = 101;
+        for (const auto & word : words) {
+            const int n = word.size();
+            const std::map<std::string, bert_vocab_id> * token_map = &token_to_id;
+            int i = 0;
+            while (i < n && t < n_max_tokens - 1) {
+                int j = n;
+                for (; j > i; j--) {
+                    auto it = token_map->find(word.substr(i, j - i));
+                    if (it != token_map->end()) {
+                        tokens[t++] = it->second;
+                        break;
+                    }
+                }
+                i = j > i ? j : i + 1;
+                token_map = &subword_token_to_id;
+            }
+        }
+        tokens[t++] = 102;
+        *n_tokens = t;
+    }
+};
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+    params.prompt = "examples/sample_client_texts.txt";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    bert_ctx * bctx;
+
+    // load the model
+    {
+        if ((bctx = bert_load_from_file(params.model)) == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+    }
+
+    // the prompt is the path of the texts
+    std::vector<std::string> texts;
+    size_t n_bytes = 0;
+    {
+        std::ifstream fin(params.prompt);
+        if (!fin) {
+            fprintf(stderr, "%s: failed to open '%s'\n", __func__, params.prompt);
+            return 1;
+        }
+        std::string line;
+        while (std::getline(fin, line)) {
+            n_bytes += line.size();
+            texts.push_back(line);
+        }
+    }
+
+    const int n_iter = 10;
+    const int N = bert_n_max_tokens(bctx);
+    std::vector<bert_vocab_id> tokens(N);
+    int64_t n_tokens_total = 0;
+
+    std::vector<const char *> text_ptrs;
+    for (const auto & text : texts) {
+        text_ptrs.push_back(text.c_str());
+    }
+
+    const baseline_tokenizer baseline(bctx);
+
+    // texts that both tokenizers split the same way, they differ on text the accent map doesn't cover
+    int n_same = 0;
+    {
+        std::vector<bert_vocab_id> tokens_base(N);
+        for (const auto & text : texts) {
+            int32_t n_tokens = 0;
+            int32_t n_tokens_base = 0;
+            bert_tokenize(bctx, text.c_str(), tokens.data(), &n_tokens, N);
+            baseline.tokenize(text.c_str(), tokens_base.data(), &n_tokens_base, N);
+            n_same += n_tokens == n_tokens_base && std::equal(tokens.begin(), tokens.begin() + n_tokens, tokens_base.begin());
+        }
+    }
+
+    // seconds to tokenize all texts n_iter times with the baseline, one by one or with bert_tokenize_batch
+    auto run = [&](bool base, bool batch) {
+        n_tokens_total = 0;
+        const int64_t t_start_us = ggml_time_us();
+        for (int it = 0; it < n_iter; it++) {
+            if (base) {
+                for (const auto & text : texts) {
+                    int32_t n_tokens = 0;
+                    baseline.tokenize(text.c_str(), tokens.data(), &n_tokens, N);
+                    n_tokens_total += n_tokens;
+                }
+                continue;
+            }
+            if (batch) {
+                bert_tokens result = bert_tokenize_batch(bctx, params.n_threads, text_ptrs.size(), text_ptrs.data(), N);
+                n_tokens_total += result.offsets[result.n_inputs];
+                bert_tokens_free(result);
+                continue;
+            }
+            for (const auto & text : texts) {
+                int32_t n_tokens = 0;
+                bert_tokenize(bctx, text.c_str(), tokens.data(), &n_tokens, N);
+                n_tokens_total += n_tokens;
+            }
+        }
+        return (ggml_time_us() - t_start_us) / 1e6;
+    };
+
+    printf("\n%zu texts, %.2f MB, %d iterations\n", texts.size(), n_bytes / 1024.0 / 1024.0, n_iter);
+    printf("%-32s %12s %12s %10s %10s\n", "", "texts/s", "tokens/s", "MB/s", "speedup");
+    const double t_base_s = run(true, false);
+    printf("%-32s %12.0f %12.0f %10.2f %9.2fx\n", "baseline", texts.size() * n_iter / t_base_s,
+           n_tokens_total / t_base_s, n_bytes * n_iter / 1024.0 / 1024.0 / t_base_s, 1.0);
+    for (int cache = 0; cache < 2; cache++) {
+        bert_set_word_cache_size(bctx, cache ? 16 * 1024 * 1024 : 0);
+        for (int batch = 0; batch < 2; batch++) {
+            const double t_s = run(false, batch);
+
+            char label[64];
+            snprintf(label, sizeof(label), "%s%s", batch ? "bert_tokenize_batch" : "bert_tokenize", cache ? " + word cache" : "");
+            printf("%-32s %12.0f %12.0f %10.2f %9.2fx\n", label, texts.size() * n_iter / t_s,
+                   n_tokens_total / t_s, n_bytes * n_iter / 1024.0 / 1024.0 / t_s, t_base_s / t_s);
+        }
+    }
+    printf("\n%d of %zu texts tokenized the same as the baseline\n", n_same, texts.size());
+
+    bert_word_cache_stats stats = bert_get_word_cache_stats(bctx);
+    printf("word cache: %.1f%% hits, %lld words, %.2f MB\n", 100.0 * stats.n_hits / std::max<int64_t>(stats.n_hits + stats.n_misses, 1),
+           (long long) stats.n_words, stats.mem_size / 1024.0 / 1024.0);
+    printf("bert_tokenize_batch uses %d threads\n", params.n_threads);
+
+    bert_free(bctx);
+
+    return 0;
+}
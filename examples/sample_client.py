@@ -6,11 +6,51 @@ import sys
 
 N_EMBD = 384
 
-def embeddings_from_local_server(s, sock):
-    sock.sendall(s.encode())
-    data = sock.recv(N_EMBD*4)
-    floats = struct.unpack('f' * N_EMBD, data)
-    return floats
+# frames are a uint32 size, a uint16 type (status in responses), uint16 flags and the payload
+REQUEST_ENCODE = 1
+REQUEST_ENCODE_BATCH = 2
+STATUS_OK = 0
+STATUS_BAD_REQUEST = 1
+STATUS_OVERLOADED = 2
+STATUS_EXPIRED = 3
+# request flags, encoding of the embeddings in the response
+ENCODING_F32 = 0
+ENCODING_F16 = 1
+ENCODING_I8 = 2
+
+def recv_exact(sock, n):
+    buf = bytearray()
+    while len(buf) < n:
+        chunk = sock.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("server closed the connection")
+        buf += chunk
+    return bytes(buf)
+
+def send_request(sock, request_type, payload, flags=ENCODING_F32):
+    sock.sendall(struct.pack('<IHH', len(payload), request_type, flags) + payload)
+
+def recv_response(sock):
+    size, status, flags = struct.unpack('<IHH', recv_exact(sock, 8))
+    payload = recv_exact(sock, size)
+    if status != STATUS_OK:
+        raise RuntimeError(f"request failed with status {status}")
+    if flags == ENCODING_F16:
+        return np.frombuffer(payload, dtype='<f2').astype(np.float32).reshape(-1, N_EMBD)
+    if flags == ENCODING_I8:
+        return np.frombuffer(payload, dtype='i1').astype(np.float32).reshape(-1, N_EMBD) / 127.0
+    return np.frombuffer(payload, dtype='<f4').reshape(-1, N_EMBD)
+
+def embeddings_from_local_server(texts, sock, batch_size=256, encoding=ENCODING_F32):
+    # one request per batch_size texts, the server queues a limited number of texts (--max-queue)
+    # so only one request is sent at a time
+    results = []
+    for start in range(0, len(texts), batch_size):
+        chunk = [text.encode() for text in texts[start:start + batch_size]]
+        payload = struct.pack('<I', len(chunk)) + b''.join(struct.pack('<I', len(t)) + t for t in chunk)
+        send_request(sock, REQUEST_ENCODE_BATCH, payload, encoding)
+        results.extend(recv_response(sock))
+    return results
 
 host = "localhost"
 port = 8080
@@ -23,15 +63,14 @@ with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
 
     # Define the function to embed a single text
     def embed_text(text):
-        embedding = embeddings_from_local_server(text, sock)
-        return np.array(embedding)
+        return embeddings_from_local_server([text], sock)[0]
 
     txt_file = "sample_client_texts.txt"
     print(f"Loading texts from {txt_file}...")
     with open(os.path.join(os.path.dirname(__file__), txt_file), 'r') as f:
         texts = f.readlines()
 
-    embedded_texts = [embed_text(text) for text in texts]
+    embedded_texts = embeddings_from_local_server(texts, sock)
     
     print(f"Loaded {len(texts)} lines.")
 
@@ -1,36 +1,871 @@
 #include "bert.h"
 #include "ggml.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cinttypes>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
-#include <cstring>
 
-#ifdef WIN32
-#include "winsock2.h"
-#include "include_win/unistd.h"
-typedef int socklen_t;
-#define read _read
-#define close _close
-
-#define SOCKET_HANDLE SOCKET
-#else
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <unistd.h>
-#include <sys/socket.h>
 #include <arpa/inet.h>
-#define SOCKET_HANDLE int
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// epoll and an eventfd on Linux, poll and a pipe on other POSIX platforms
+#ifdef __linux__
+#define SERVER_EPOLL 1
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+// without MSG_NOSIGNAL, SIGPIPE is ignored for the whole process instead
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#define SERVER_IGNORE_SIGPIPE 1
+#endif
+
+// Protocol
+//
+// After connecting, the client receives n_embd as an int32. Then it sends request frames and receives
+// one response frame per request, in the order of the requests. Clients can send more requests
+// without waiting for the responses, and can shut down writing after the last one: the connection is
+// closed once all responses are sent.
+//
+//   request:  uint32 size, uint16 type, uint16 flags, then size bytes of payload
+//   response: uint32 size, uint16 status, uint16 flags, then size bytes of payload
+//
+// Integers are little endian. Requests of all connections are evaluated together in batches of up to
+// --batch-size texts, a request waits at most --batch-wait-us for its batch to fill.
+//
+//   REQUEST_ENCODE:       the payload is one UTF-8 text, the response is its embedding
+//   REQUEST_ENCODE_BATCH: the payload is uint32 n_texts, then n_texts times uint32 length and the text,
+//                         the response is the n_texts embeddings one after the other
+//
+// The low bits of the request flags select how the embeddings in the response are encoded,
+// the response flags repeat them:
+//
+//   ENCODING_F32: n_embd floats per embedding
+//   ENCODING_F16: n_embd halfs
+//   ENCODING_I8:  n_embd int8 of round(x * 127), the embeddings are normalized so |x| <= 1
+//
+// The other request flags:
+//
+//   FLAG_BULK:     low priority, bulk requests are only evaluated when no interactive request waits
+//   FLAG_DEADLINE: the payload starts with a uint32 number of microseconds, requests that are still
+//                  queued that long after they arrived are answered with STATUS_EXPIRED instead
+//
+// Each priority has its own queue of at most --max-queue texts, requests that don't fit are
+// answered with STATUS_OVERLOADED right away. Requests with more texts than --max-queue, or whose
+// response would be larger than a request frame may be (16 MiB of f32 embeddings), are answered with
+// STATUS_BAD_REQUEST. A connection with 1024 requests in flight isn't
+// read from until some of them are answered.
+//
+// Metrics
+//
+// With --metrics-port the server answers HTTP GET /metrics on 127.0.0.1 with its counters, queue depth
+// and latency histograms in the Prometheus text format. The workers and the I/O loop each count into
+// their own counters, a scrape only reads them.
+
+enum server_request_type : uint16_t
+{
+    REQUEST_ENCODE = 1,
+    REQUEST_ENCODE_BATCH = 2,
+};
+
+enum server_encoding : uint16_t
+{
+    ENCODING_F32 = 0,
+    ENCODING_F16 = 1,
+    ENCODING_I8 = 2,
+    ENCODING_MASK = 3,
+};
+
+enum server_flags : uint16_t
+{
+    FLAG_BULK = 1 << 2,
+    FLAG_DEADLINE = 1 << 3,
+};
+
+enum server_status : uint16_t
+{
+    STATUS_OK = 0,
+    STATUS_BAD_REQUEST = 1,
+    STATUS_OVERLOADED = 2,
+    STATUS_EXPIRED = 3,
+    STATUS_COUNT = 4,
+};
+
+static const char * SERVER_STATUS_NAMES[STATUS_COUNT] = { "ok", "bad_request", "overloaded", "expired" };
+
+enum server_priority
+{
+    PRIORITY_INTERACTIVE = 0,
+    PRIORITY_BULK = 1,
+    PRIORITY_COUNT = 2,
+};
+
+static const char * SERVER_PRIORITY_NAMES[PRIORITY_COUNT] = { "interactive", "bulk" };
+
+struct server_frame_header
+{
+    uint32_t size;
+    uint16_t type; // status in responses
+    uint16_t flags;
+};
+
+static const uint32_t SERVER_MAX_FRAME_SIZE = 16 << 20;
+static const size_t SERVER_MAX_PENDING = 1024;
+
+static const std::vector<int64_t> SERVER_LATENCY_BOUNDS_US = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000,
+};
+static const std::vector<int64_t> SERVER_BATCH_BOUNDS = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
+static const size_t SERVER_MAX_BUCKETS = 16;
+
+// Counts observations into buckets by upper bound. Every histogram has a single writer, the atomics
+// only keep a concurrent scrape from reading torn values
+struct server_histogram
+{
+    const std::vector<int64_t> & bounds;
+    std::atomic<uint64_t> counts[SERVER_MAX_BUCKETS + 1] = {}; // the last bucket is +Inf
+    std::atomic<int64_t> sum{0};
+
+    explicit server_histogram(const std::vector<int64_t> & bounds) : bounds(bounds) {}
+
+    void observe(int64_t value) {
+        const size_t i = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+        counts[i].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+};
+
+// Written by one worker, padded so that workers don't share cache lines
+struct alignas(64) server_worker_metrics
+{
+    std::atomic<uint64_t> n_tokens{0};  // real tokens evaluated
+    std::atomic<uint64_t> n_padding{0}; // padding tokens evaluated
+    std::atomic<int64_t> t_eval_us{0};
+    server_histogram batch_texts{SERVER_BATCH_BOUNDS}; // texts per batch taken from the queue
+    server_histogram queue_us{SERVER_LATENCY_BOUNDS_US}; // arrival until the batch is taken
+    server_histogram tokenize_us{SERVER_LATENCY_BOUNDS_US};
+    server_histogram eval_us{SERVER_LATENCY_BOUNDS_US};
+};
+
+// Written by the I/O loop
+struct server_io_metrics
+{
+    std::atomic<uint64_t> n_accepted{0};
+    std::atomic<int64_t> n_open{0};
+    std::atomic<uint64_t> n_requests[PRIORITY_COUNT] = {};
+    std::atomic<uint64_t> n_texts[PRIORITY_COUNT] = {};
+    std::atomic<uint64_t> n_responses[STATUS_COUNT] = {};
+    server_histogram send_us{SERVER_LATENCY_BOUNDS_US};    // response ready until it is sent
+    server_histogram request_us{SERVER_LATENCY_BOUNDS_US}; // arrival until the response is sent
+};
+
+struct server_request
+{
+    uint64_t conn_id;
+    uint16_t type;
+    uint16_t encoding;
+    std::vector<std::string> texts;
+    server_priority priority = PRIORITY_INTERACTIVE;
+    std::chrono::steady_clock::time_point t_arrival;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    std::atomic<bool> cancelled{false}; // the connection is gone
+
+    // written by the worker before done is set, the response payload is embeddings or encoded
+    server_frame_header response = {};
+    std::vector<float> embeddings;
+    std::vector<uint8_t> encoded;
+    const void * payload = nullptr;
+    std::chrono::steady_clock::time_point t_done;
+    std::atomic<bool> done{false};
+};
+
+struct server_connection
+{
+    int fd;
+    uint64_t id;
+
+    std::string in;       // received bytes that aren't a complete frame yet
+    size_t out_sent = 0;  // bytes of the first pending response already sent
+    bool want_write = false;
+    bool eof = false;     // the client shut down writing, it sends no more requests
+    uint32_t events = POLLIN; // registered with the poller
+
+    // requests in the order they arrived, responses are sent from the front once they are done
+    std::deque<std::shared_ptr<server_request>> pending;
+};
+
+// Requests waiting for a worker, one queue per priority
+struct server_queue
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<server_request>> requests[PRIORITY_COUNT];
+    std::atomic<size_t> n_texts[PRIORITY_COUNT] = {}; // texts of the queued requests, read by the metrics without the lock
+    size_t n_max_texts = 0;
+    bool stop = false;
+
+    // Returns false if the queue of the priority of the request is full
+    bool push(std::shared_ptr<server_request> req) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const int p = req->priority;
+            if (n_texts[p] + req->texts.size() > n_max_texts) {
+                return false;
+            }
+            n_texts[p] += req->texts.size();
+            requests[p].push_back(std::move(req));
+        }
+        cv.notify_one();
+        return true;
+    }
+
+    // Takes requests with up to n_max texts (at least one request), interactive ones first, once there
+    // are n_max texts or the oldest request has waited max_wait. Lower priority requests only fill the
+    // batch when no higher priority request is left waiting. Requests that expired or whose connection
+    // is gone are moved to dropped instead, from anywhere in the queues. Returns nothing once the queue
+    // is stopped.
+    std::vector<std::shared_ptr<server_request>> pop_batch(
+            size_t n_max, std::chrono::microseconds max_wait, std::vector<std::shared_ptr<server_request>> & dropped) {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<std::shared_ptr<server_request>> batch;
+        while (batch.empty() && dropped.empty()) {
+            cv.wait(lock, [&] { return stop || !requests[PRIORITY_INTERACTIVE].empty() || !requests[PRIORITY_BULK].empty(); });
+            if (stop) {
+                return {};
+            }
+            auto oldest = std::chrono::steady_clock::time_point::max();
+            for (auto & queue : requests) {
+                if (!queue.empty()) {
+                    oldest = std::min(oldest, queue.front()->t_arrival);
+                }
+            }
+            cv.wait_until(lock, oldest + max_wait, [&] { return stop || n_texts[PRIORITY_INTERACTIVE] + n_texts[PRIORITY_BULK] >= n_max; });
+            if (stop) {
+                return {};
+            }
+
+            // sweep the whole queues, a dropped request behind one that doesn't fit would still count
+            // against --max-queue
+            const auto now = std::chrono::steady_clock::now();
+            for (int p = 0; p < PRIORITY_COUNT; p++) {
+                auto & queue = requests[p];
+                for (auto it = queue.begin(); it != queue.end();) {
+                    if ((*it)->cancelled.load(std::memory_order_relaxed) || (*it)->deadline < now) {
+                        n_texts[p] -= (*it)->texts.size();
+                        dropped.push_back(std::move(*it));
+                        it = queue.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            // another worker may have taken them in the meantime
+            size_t n_batch_texts = 0;
+            for (int p = 0; p < PRIORITY_COUNT; p++) {
+                auto & queue = requests[p];
+                while (!queue.empty()) {
+                    const size_t n = queue.front()->texts.size();
+                    if (!batch.empty() && n_batch_texts + n > n_max) {
+                        break;
+                    }
+                    n_batch_texts += n;
+                    n_texts[p] -= n;
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+                if (!queue.empty()) {
+                    break;
+                }
+            }
+        }
+        return batch;
+    }
+};
+
+static bool server_set_nonblocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Connections with finished requests, the workers wake the I/O loop through an eventfd (a pipe
+// without eventfd), the loop waits for event_fd to become readable
+struct server_completions
+{
+    int event_fd = -1;
+    int wake_fd = -1; // the same eventfd, or the write end of the pipe
+    std::mutex mutex;
+    std::vector<uint64_t> conn_ids;
+
+    bool open() {
+#ifdef SERVER_EPOLL
+        event_fd = wake_fd = eventfd(0, EFD_NONBLOCK);
+        return event_fd >= 0;
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+        event_fd = fds[0];
+        wake_fd = fds[1];
+        return server_set_nonblocking(event_fd) && server_set_nonblocking(wake_fd);
 #endif
+    }
+
+    void push(const std::vector<uint64_t> & ids) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            conn_ids.insert(conn_ids.end(), ids.begin(), ids.end());
+        }
+        const uint64_t one = 1;
+        if (write(wake_fd, &one, sizeof(one)) < 0) {
+            // the counter is already non-zero, or the pipe is full
+        }
+    }
+
+    std::vector<uint64_t> take() {
+        uint64_t count;
+        while (read(event_fd, &count, sizeof(count)) > 0) {
+            // drains the pipe, an eventfd is reset by the first read
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::move(conn_ids);
+    }
+};
+
+// Waits for the sockets of the I/O loop. Each fd is registered with an id that wait reports along
+// with the POLLIN, POLLOUT, POLLHUP and POLLERR bits that are set
+struct server_poller
+{
+    struct event
+    {
+        uint64_t id;
+        uint32_t events;
+    };
+
+#ifdef SERVER_EPOLL
+    static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLHUP == POLLHUP && EPOLLERR == POLLERR,
+                  "epoll and poll events differ");
+
+    int epoll_fd = epoll_create1(0);
+    std::vector<struct epoll_event> ready = std::vector<struct epoll_event>(256);
+
+    bool ctl(int op, int fd, uint64_t id, uint32_t events) {
+        struct epoll_event ev = {};
+        ev.events = events;
+        ev.data.u64 = id;
+        return epoll_ctl(epoll_fd, op, fd, &ev) == 0;
+    }
+
+    bool add(int fd, uint64_t id, uint32_t events) { return ctl(EPOLL_CTL_ADD, fd, id, events); }
+    void modify(int fd, uint64_t id, uint32_t events) { ctl(EPOLL_CTL_MOD, fd, id, events); }
+    void remove(int fd) { epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr); }
+
+    // Returns false if waiting failed
+    bool wait(std::vector<event> & events) {
+        events.clear();
+        const int n = epoll_wait(epoll_fd, ready.data(), ready.size(), -1);
+        if (n < 0) {
+            return errno == EINTR;
+        }
+        for (int i = 0; i < n; i++) {
+            events.push_back({ ready[i].data.u64, ready[i].events });
+        }
+        return true;
+    }
+#else
+    std::vector<struct pollfd> fds;
+    std::vector<uint64_t> ids;
+    std::unordered_map<int, size_t> index; // fd to its position in fds
+
+    bool add(int fd, uint64_t id, uint32_t events) {
+        index[fd] = fds.size();
+        fds.push_back({ fd, (short) events, 0 });
+        ids.push_back(id);
+        return true;
+    }
+
+    void modify(int fd, uint64_t, uint32_t events) {
+        fds[index.at(fd)].events = (short) events;
+    }
 
+    void remove(int fd) {
+        const size_t i = index.at(fd);
+        index.erase(fd);
+        if (i + 1 != fds.size()) {
+            fds[i] = fds.back();
+            ids[i] = ids.back();
+            index[fds[i].fd] = i;
+        }
+        fds.pop_back();
+        ids.pop_back();
+    }
 
+    bool wait(std::vector<event> & events) {
+        events.clear();
+        const int n = poll(fds.data(), fds.size(), -1);
+        if (n < 0) {
+            return errno == EINTR;
+        }
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].revents != 0) {
+                events.push_back({ ids[i], (uint32_t) fds[i].revents });
+            }
+        }
+        return true;
+    }
+#endif
+};
 
-std::string receive_string(SOCKET_HANDLE socket) {
-    static char buffer[1 << 15] = {0};
-    ssize_t bytes_received = read(socket, buffer, sizeof(buffer));
-    return std::string(buffer, bytes_received);
+// Points the response at the embeddings of the request in its encoding
+static void server_encode_response(server_request & req) {
+    const size_t n = req.embeddings.size();
+    req.response.type = STATUS_OK;
+    req.response.flags = req.encoding;
+    switch (req.encoding) {
+        case ENCODING_F16:
+            req.encoded.resize(n * sizeof(ggml_fp16_t));
+            ggml_fp32_to_fp16_row(req.embeddings.data(), (ggml_fp16_t *) req.encoded.data(), n);
+            req.payload = req.encoded.data();
+            req.response.size = req.encoded.size();
+            break;
+        case ENCODING_I8:
+            req.encoded.resize(n);
+            for (size_t i = 0; i < n; i++) {
+                req.encoded[i] = (uint8_t) (int8_t) std::lround(std::min(std::max(req.embeddings[i], -1.0f), 1.0f) * 127.0f);
+            }
+            req.payload = req.encoded.data();
+            req.response.size = req.encoded.size();
+            break;
+        default:
+            req.payload = req.embeddings.data();
+            req.response.size = n * sizeof(float);
+            break;
+    }
 }
 
-void send_floats(SOCKET_HANDLE socket, const std::vector<float> floats) {
-    send(socket, (const char *)floats.data(), floats.size() * sizeof(float), 0);
+static void server_worker(
+        bert_ctx * bctx, const bert_params & params, int32_t n_threads, server_queue & queue, server_completions & completions,
+        server_worker_metrics & metrics) {
+    bert_state * state = bert_state_new(bctx);
+    const int n_embd = bert_n_embd(bctx);
+    const size_t n_batch_size = std::max(params.n_batch_size, 1);
+    const std::chrono::microseconds max_wait(params.batch_wait_us);
+
+    std::vector<const char *> texts;
+    std::vector<float *> embeddings;
+    std::vector<uint64_t> conn_ids;
+    std::vector<std::shared_ptr<server_request>> dropped;
+    while (true) {
+        dropped.clear();
+        auto batch = queue.pop_batch(n_batch_size, max_wait, dropped);
+        if (batch.empty() && dropped.empty()) {
+            break;
+        }
+
+        conn_ids.clear();
+        auto now = std::chrono::steady_clock::now();
+        for (auto & req : dropped) {
+            req->response.type = STATUS_EXPIRED;
+            req->t_done = now;
+            req->done.store(true, std::memory_order_release);
+            conn_ids.push_back(req->conn_id);
+        }
+        if (batch.empty()) {
+            completions.push(conn_ids);
+            continue;
+        }
+
+        // the texts of all requests go into one call, bert_encode_batch splits them into batches
+        texts.clear();
+        embeddings.clear();
+        for (auto & req : batch) {
+            metrics.queue_us.observe(std::chrono::duration_cast<std::chrono::microseconds>(now - req->t_arrival).count());
+            req->embeddings.resize(req->texts.size() * n_embd);
+            for (size_t i = 0; i < req->texts.size(); i++) {
+                texts.push_back(req->texts[i].c_str());
+                embeddings.push_back(req->embeddings.data() + i * n_embd);
+            }
+        }
+        bert_state_encode_batch(state, n_threads, n_batch_size, texts.size(), texts.data(), embeddings.data());
+
+        const bert_batch_stats stats = bert_state_get_batch_stats(state);
+        metrics.n_tokens.fetch_add(stats.n_tokens, std::memory_order_relaxed);
+        metrics.n_padding.fetch_add(stats.n_padding, std::memory_order_relaxed);
+        metrics.t_eval_us.fetch_add(stats.t_eval_us, std::memory_order_relaxed);
+        metrics.batch_texts.observe(texts.size());
+        metrics.tokenize_us.observe(stats.t_tokenize_us);
+        metrics.eval_us.observe(stats.t_eval_us);
+
+        now = std::chrono::steady_clock::now();
+        for (auto & req : batch) {
+            server_encode_response(*req);
+            req->t_done = now;
+            req->done.store(true, std::memory_order_release);
+            conn_ids.push_back(req->conn_id);
+        }
+        completions.push(conn_ids);
+    }
+
+    bert_state_free(state);
+}
+
+// Sends the finished responses at the front of the connection with one sendmsg,
+// returns false if the connection failed
+static bool server_flush(server_connection & conn, server_io_metrics & metrics) {
+    while (true) {
+        std::vector<struct iovec> iov;
+        for (const auto & req : conn.pending) {
+            if (!req->done.load(std::memory_order_acquire) || iov.size() + 2 > IOV_MAX) {
+                break;
+            }
+            iov.push_back({&req->response, sizeof(req->response)});
+            if (req->response.size > 0) {
+                iov.push_back({(void *) req->payload, req->response.size});
+            }
+        }
+        if (iov.empty()) {
+            conn.want_write = false;
+            return true;
+        }
+
+        // skip what an earlier partial send already covered
+        size_t skip = conn.out_sent;
+        size_t first = 0;
+        while (skip >= iov[first].iov_len) {
+            skip -= iov[first].iov_len;
+            first++;
+        }
+        iov[first].iov_base = (char *) iov[first].iov_base + skip;
+        iov[first].iov_len -= skip;
+
+        struct msghdr msg = {};
+        msg.msg_iov = iov.data() + first;
+        msg.msg_iovlen = iov.size() - first;
+        ssize_t n_sent = sendmsg(conn.fd, &msg, MSG_NOSIGNAL);
+        if (n_sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                conn.want_write = true;
+                return true;
+            }
+            return false;
+        }
+
+        // drop the responses that went out completely
+        const auto now = std::chrono::steady_clock::now();
+        size_t n = conn.out_sent + n_sent;
+        while (!conn.pending.empty() && conn.pending.front()->done.load(std::memory_order_acquire)) {
+            const server_request & req = *conn.pending.front();
+            const size_t len = sizeof(server_frame_header) + req.response.size;
+            if (n < len) {
+                break;
+            }
+            n -= len;
+            metrics.n_responses[req.response.type].fetch_add(1, std::memory_order_relaxed);
+            metrics.send_us.observe(std::chrono::duration_cast<std::chrono::microseconds>(now - req.t_done).count());
+            metrics.request_us.observe(std::chrono::duration_cast<std::chrono::microseconds>(now - req.t_arrival).count());
+            conn.pending.pop_front();
+        }
+        conn.out_sent = n;
+    }
+}
+
+// Reads the texts of a REQUEST_ENCODE_BATCH payload, returns false if it is malformed or has more
+// than n_max_texts texts
+static bool server_parse_texts(const char * data, size_t size, size_t n_max_texts, std::vector<std::string> & texts) {
+    uint32_t n_texts;
+    if (size < sizeof(n_texts)) {
+        return false;
+    }
+    memcpy(&n_texts, data, sizeof(n_texts));
+    size_t pos = sizeof(n_texts);
+    // every text takes at least its length, checked before anything is allocated
+    if (n_texts > n_max_texts || n_texts > (size - pos) / sizeof(uint32_t)) {
+        return false;
+    }
+    texts.resize(n_texts);
+    for (auto & text : texts) {
+        uint32_t len;
+        if (size - pos < sizeof(len)) {
+            return false;
+        }
+        memcpy(&len, data + pos, sizeof(len));
+        pos += sizeof(len);
+        if (size - pos < len) {
+            return false;
+        }
+        text.assign(data + pos, len);
+        pos += len;
+    }
+    return pos == size;
+}
+
+// Splits the received bytes into requests until the connection has SERVER_MAX_PENDING requests in flight,
+// returns false if a frame is too large to be a request. Batches of more than n_max_texts texts are bad requests
+static bool server_parse(server_connection & conn, server_queue & queue, size_t n_max_texts, server_io_metrics & metrics) {
+    size_t pos = 0;
+    while (conn.in.size() - pos >= sizeof(server_frame_header) && conn.pending.size() < SERVER_MAX_PENDING) {
+        server_frame_header header;
+        memcpy(&header, conn.in.data() + pos, sizeof(header));
+        if (header.size > SERVER_MAX_FRAME_SIZE) {
+            return false;
+        }
+        if (conn.in.size() - pos - sizeof(header) < header.size) {
+            break;
+        }
+
+        auto req = std::make_shared<server_request>();
+        req->conn_id = conn.id;
+        req->type = header.type;
+        req->encoding = header.flags & ENCODING_MASK;
+        conn.pending.push_back(req);
+
+        req->priority = header.flags & FLAG_BULK ? PRIORITY_BULK : PRIORITY_INTERACTIVE;
+        req->t_arrival = std::chrono::steady_clock::now();
+
+        const char * payload = conn.in.data() + pos + sizeof(header);
+        uint32_t size = header.size;
+        bool ok = req->encoding <= ENCODING_I8;
+        if (ok && (header.flags & FLAG_DEADLINE)) {
+            uint32_t timeout_us;
+            ok = size >= sizeof(timeout_us);
+            if (ok) {
+                memcpy(&timeout_us, payload, sizeof(timeout_us));
+                req->deadline = req->t_arrival + std::chrono::microseconds(timeout_us);
+                payload += sizeof(timeout_us);
+                size -= sizeof(timeout_us);
+            }
+        }
+        if (header.type == REQUEST_ENCODE) {
+            req->texts.emplace_back(payload, size);
+        } else if (header.type == REQUEST_ENCODE_BATCH) {
+            ok = ok && server_parse_texts(payload, size, n_max_texts, req->texts);
+        } else {
+            ok = false;
+        }
+
+        metrics.n_requests[req->priority].fetch_add(1, std::memory_order_relaxed);
+        metrics.n_texts[req->priority].fetch_add(req->texts.size(), std::memory_order_relaxed);
+
+        // bad, empty and refused requests are answered right away, in order with the other responses
+        req->t_done = req->t_arrival;
+        if (!ok) {
+            req->response.type = STATUS_BAD_REQUEST;
+            req->done = true;
+        } else if (req->texts.empty()) {
+            server_encode_response(*req);
+            req->done = true;
+        } else if (!queue.push(req)) {
+            req->response.type = STATUS_OVERLOADED;
+            req->done = true;
+        }
+
+        pos += sizeof(header) + header.size;
+    }
+    conn.in.erase(0, pos);
+    return true;
+}
+
+static void server_print_help(std::string & out, const char * name, const char * type, const char * help) {
+    out += "# HELP ";
+    out += name;
+    out += " ";
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += " ";
+    out += type;
+    out += "\n";
+}
+
+static void server_print_value(std::string & out, const char * name, const char * labels, double value) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s%s %.10g\n", name, labels, value);
+    out += buf;
+}
+
+static void server_print_metric(std::string & out, const char * name, const char * type, const char * help, double value) {
+    server_print_help(out, name, type, help);
+    server_print_value(out, name, "", value);
+}
+
+// Sums the histograms and prints them with the bounds divided by scale
+static void server_print_histogram(
+        std::string & out, const char * name, const char * help, const std::vector<const server_histogram *> & hists, double scale) {
+    server_print_help(out, name, "histogram", help);
+    const std::vector<int64_t> & bounds = hists[0]->bounds;
+    char buf[256];
+    uint64_t count = 0;
+    int64_t sum = 0;
+    for (size_t i = 0; i <= bounds.size(); i++) {
+        for (const server_histogram * hist : hists) {
+            count += hist->counts[i].load(std::memory_order_relaxed);
+        }
+        if (i < bounds.size()) {
+            snprintf(buf, sizeof(buf), "%s_bucket{le=\"%g\"} %" PRIu64 "\n", name, bounds[i] / scale, count);
+        } else {
+            snprintf(buf, sizeof(buf), "%s_bucket{le=\"+Inf\"} %" PRIu64 "\n", name, count);
+        }
+        out += buf;
+    }
+    for (const server_histogram * hist : hists) {
+        sum += hist->sum.load(std::memory_order_relaxed);
+    }
+    snprintf(buf, sizeof(buf), "%s_sum %.10g\n%s_count %" PRIu64 "\n", name, sum / scale, name, count);
+    out += buf;
+}
+
+static std::string server_format_metrics(
+        bert_ctx * bctx, server_queue & queue, const server_io_metrics & io, const std::vector<server_worker_metrics> & workers,
+        std::chrono::steady_clock::time_point t_start) {
+    std::string out;
+    char labels[64];
+
+    const double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    server_print_metric(out, "bert_server_uptime_seconds", "gauge", "Time since the server started.", uptime);
+    server_print_metric(out, "bert_server_connections_accepted_total", "counter", "Accepted connections.", io.n_accepted.load());
+    server_print_metric(out, "bert_server_connections_open", "gauge", "Open connections.", io.n_open.load());
+
+    server_print_help(out, "bert_server_requests_total", "counter", "Received requests.");
+    for (int p = 0; p < PRIORITY_COUNT; p++) {
+        snprintf(labels, sizeof(labels), "{priority=\"%s\"}", SERVER_PRIORITY_NAMES[p]);
+        server_print_value(out, "bert_server_requests_total", labels, io.n_requests[p].load());
+    }
+    server_print_help(out, "bert_server_texts_total", "counter", "Texts in the received requests.");
+    for (int p = 0; p < PRIORITY_COUNT; p++) {
+        snprintf(labels, sizeof(labels), "{priority=\"%s\"}", SERVER_PRIORITY_NAMES[p]);
+        server_print_value(out, "bert_server_texts_total", labels, io.n_texts[p].load());
+    }
+    server_print_help(out, "bert_server_responses_total", "counter", "Sent responses.");
+    for (int s = 0; s < STATUS_COUNT; s++) {
+        snprintf(labels, sizeof(labels), "{status=\"%s\"}", SERVER_STATUS_NAMES[s]);
+        server_print_value(out, "bert_server_responses_total", labels, io.n_responses[s].load());
+    }
+    server_print_help(out, "bert_server_queue_texts", "gauge", "Texts waiting for a worker.");
+    for (int p = 0; p < PRIORITY_COUNT; p++) {
+        snprintf(labels, sizeof(labels), "{priority=\"%s\"}", SERVER_PRIORITY_NAMES[p]);
+        server_print_value(out, "bert_server_queue_texts", labels, queue.n_texts[p].load());
+    }
+
+    uint64_t n_tokens = 0;
+    uint64_t n_padding = 0;
+    int64_t t_eval_us = 0;
+    std::vector<const server_histogram *> batch_texts, queue_us, tokenize_us, eval_us;
+    for (const auto & worker : workers) {
+        n_tokens += worker.n_tokens.load(std::memory_order_relaxed);
+        n_padding += worker.n_padding.load(std::memory_order_relaxed);
+        t_eval_us += worker.t_eval_us.load(std::memory_order_relaxed);
+        batch_texts.push_back(&worker.batch_texts);
+        queue_us.push_back(&worker.queue_us);
+        tokenize_us.push_back(&worker.tokenize_us);
+        eval_us.push_back(&worker.eval_us);
+    }
+    server_print_metric(out, "bert_server_tokens_total", "counter", "Real tokens evaluated.", n_tokens);
+    server_print_metric(out, "bert_server_padding_tokens_total", "counter", "Padding tokens evaluated.", n_padding);
+    server_print_metric(out, "bert_server_padding_ratio", "gauge", "Share of the evaluated tokens that were padding.",
+            n_tokens + n_padding > 0 ? (double) n_padding / (n_tokens + n_padding) : 0.0);
+    server_print_metric(out, "bert_server_tokens_per_second", "gauge", "Real tokens evaluated per second of evaluation, summed over the workers.",
+            t_eval_us > 0 ? n_tokens * 1e6 / t_eval_us : 0.0);
+    server_print_histogram(out, "bert_server_batch_texts", "Texts per batch taken from the queue.", batch_texts, 1.0);
+    server_print_histogram(out, "bert_server_queue_seconds", "Time requests waited for a worker.", queue_us, 1e6);
+    server_print_histogram(out, "bert_server_tokenize_seconds", "Time a worker spent tokenizing a batch.", tokenize_us, 1e6);
+    server_print_histogram(out, "bert_server_eval_seconds", "Time a worker spent evaluating a batch.", eval_us, 1e6);
+    server_print_histogram(out, "bert_server_send_seconds", "Time from a finished response until it was sent.", {&io.send_us}, 1e6);
+    server_print_histogram(out, "bert_server_request_seconds", "Time from a received request until its response was sent.", {&io.request_us}, 1e6);
+
+    const bert_embedding_cache_stats cache = bert_get_embedding_cache_stats(bctx);
+    if (cache.max_mem_size > 0) {
+        server_print_metric(out, "bert_embedding_cache_hits_total", "counter", "Inputs found in the embedding cache.", cache.n_hits);
+        server_print_metric(out, "bert_embedding_cache_misses_total", "counter", "Inputs not found in the embedding cache.", cache.n_misses);
+        server_print_metric(out, "bert_embedding_cache_evictions_total", "counter", "Embeddings evicted from the cache.", cache.n_evictions);
+        server_print_metric(out, "bert_embedding_cache_entries", "gauge", "Embeddings in the cache.", cache.n_entries);
+        server_print_metric(out, "bert_embedding_cache_bytes", "gauge", "Memory used by the embedding cache.", cache.mem_size);
+    }
+    const bert_word_cache_stats words = bert_get_word_cache_stats(bctx);
+    if (words.max_mem_size > 0) {
+        server_print_metric(out, "bert_word_cache_hits_total", "counter", "Words found in the word cache.", words.n_hits);
+        server_print_metric(out, "bert_word_cache_misses_total", "counter", "Words not found in the word cache.", words.n_misses);
+        server_print_metric(out, "bert_word_cache_bytes", "gauge", "Memory used by the word cache.", words.mem_size);
+    }
+    const bert_embedding_store_stats store = bert_get_embedding_store_stats(bctx);
+    if (store.max_size > 0) {
+        server_print_metric(out, "bert_embedding_store_hits_total", "counter", "Inputs read from the embedding store.", store.n_hits);
+        server_print_metric(out, "bert_embedding_store_misses_total", "counter", "Inputs not found in the embedding store.", store.n_misses);
+        server_print_metric(out, "bert_embedding_store_appends_total", "counter", "Embeddings appended to the store.", store.n_appends);
+        server_print_metric(out, "bert_embedding_store_bytes", "gauge", "Used size of the embedding store file.", store.size);
+    }
+    return out;
+}
+
+// Answers HTTP requests on the blocking metrics socket until it is shut down
+static void server_metrics_loop(int metrics_fd, const std::function<std::string()> & format) {
+    while (true) {
+        const int fd = accept(metrics_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+        struct timeval timeout = { 1, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        // only the request line matters, the rest of the head is read so closing doesn't reset the connection
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            const ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0) {
+                break;
+            }
+            request.append(buf, n);
+        }
+
+        std::string body;
+        std::string response;
+        if (request.compare(0, 13, "GET /metrics ") == 0) {
+            body = format();
+            response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n";
+        } else {
+            body = "not found\n";
+            response = "HTTP/1.0 404 Not Found\r\nContent-Type: text/plain\r\n";
+        }
+        response += "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+
+        size_t pos = 0;
+        while (pos < response.size()) {
+            const ssize_t n = send(fd, response.data() + pos, response.size() - pos, MSG_NOSIGNAL);
+            if (n <= 0) {
+                break;
+            }
+            pos += n;
+        }
+        close(fd);
+    }
 }
 
 int main(int argc, char ** argv) {
@@ -51,35 +886,19 @@ int main(int argc, char ** argv) {
         }
     }
 
-    SOCKET_HANDLE server_fd, new_socket;
-    struct sockaddr_in address;
-    int addrlen = sizeof(address);
-
-
-#if WIN32
-    WORD wVersionRequested;
-    WSADATA wsaData;
-    int err;
-
-    /* Use the MAKEWORD(lowbyte, highbyte) macro declared in Windef.h */
-    wVersionRequested = MAKEWORD(2, 2);
-
-    err = WSAStartup(wVersionRequested, &wsaData);
-    if (err != 0) {
-        /* Tell the user that we could not find a usable */
-        /* Winsock DLL.                                  */
-        printf("WSAStartup failed with error: %d\n", err);
-        return 1;
-    }
-
+#ifdef SERVER_IGNORE_SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
 #endif
 
-
-    if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
+    int server_fd;
+    if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) < 0 || !server_set_nonblocking(server_fd)) {
         std::cerr << "Socket creation failed" << std::endl;
         return -1;
     }
+    const int reuse = 1;
+    setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
 
+    struct sockaddr_in address = {};
     address.sin_family = AF_INET;
     address.sin_addr.s_addr = INADDR_ANY;
     address.sin_port = htons(params.port);
@@ -89,36 +908,203 @@ int main(int argc, char ** argv) {
         return -1;
     }
 
-    if (listen(server_fd, 1) < 0) {
+    if (listen(server_fd, SOMAXCONN) < 0) {
         std::cerr << "Listen failed" << std::endl;
         return -1;
     }
 
-    std::cout << "Server running on port " << params.port << " with " << params.n_threads << " threads" << std::endl;
+    if (params.embedding_cache_mb > 0) {
+        bert_set_embedding_cache_size(bctx, (size_t) params.embedding_cache_mb << 20);
+    }
+
+    // eval runs on the workers, the main thread only does I/O
+    const int n_workers = std::max(params.n_workers, 1);
+    const int n_threads = std::max(params.n_threads / n_workers, 1);
     int n_embd = bert_n_embd(bctx);
+    server_queue queue;
+    queue.n_max_texts = std::max(params.n_max_queue, 1);
+    // a request has to fit the queue, and its response the 32 bit frame size
+    const size_t n_max_request_texts = std::min<size_t>(queue.n_max_texts, SERVER_MAX_FRAME_SIZE / (n_embd * sizeof(float)));
+    server_completions completions;
+    if (!completions.open()) {
+        std::cerr << "Event fd creation failed" << std::endl;
+        return -1;
+    }
 
-    while(true) {
-        std::cout << "Waiting for a client" << std::endl;
-        if ((new_socket = accept(server_fd, (struct sockaddr *)&address, (socklen_t *)&addrlen)) < 0) {
-            std::cerr << "Accept failed" << std::endl;
+    const auto t_start = std::chrono::steady_clock::now();
+    server_io_metrics io_metrics;
+    std::vector<server_worker_metrics> worker_metrics(n_workers);
+
+    // the metrics are only served locally, on their own blocking socket and thread
+    int metrics_fd = -1;
+    std::thread metrics_thread;
+    if (params.metrics_port > 0) {
+        struct sockaddr_in metrics_address = {};
+        metrics_address.sin_family = AF_INET;
+        metrics_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        metrics_address.sin_port = htons(params.metrics_port);
+        metrics_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (metrics_fd < 0
+                || setsockopt(metrics_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0
+                || bind(metrics_fd, (struct sockaddr *)&metrics_address, sizeof(metrics_address)) < 0
+                || listen(metrics_fd, 16) < 0) {
+            std::cerr << "Metrics bind failed" << std::endl;
             return -1;
         }
-        std::cout << "New connection" << std::endl;
-        send(new_socket, (const char *) & n_embd, sizeof(int), 0);
-        while(true) {
-            std::string string_in = receive_string(new_socket);
-            if (string_in.empty()) {
-                break;
+        metrics_thread = std::thread(server_metrics_loop, metrics_fd, [&] {
+            return server_format_metrics(bctx, queue, io_metrics, worker_metrics, t_start);
+        });
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < n_workers; i++) {
+        workers.emplace_back(server_worker, bctx, std::cref(params), n_threads, std::ref(queue), std::ref(completions), std::ref(worker_metrics[i]));
+    }
+
+    // the poller reports connection ids, 0 and 1 are the listening socket and the completions
+    const uint64_t LISTEN_ID = 0;
+    const uint64_t EVENT_ID = 1;
+    uint64_t next_id = 2;
+    std::unordered_map<uint64_t, std::unique_ptr<server_connection>> connections;
+
+    server_poller poller;
+    poller.add(server_fd, LISTEN_ID, POLLIN);
+    poller.add(completions.event_fd, EVENT_ID, POLLIN);
+
+    std::cout << "Server running on port " << params.port << " with " << n_workers << " workers of "
+              << n_threads << " threads, batches of up to " << params.n_batch_size << " texts" << std::endl;
+    if (metrics_fd >= 0) {
+        std::cout << "Metrics on http://127.0.0.1:" << params.metrics_port << "/metrics" << std::endl;
+    }
+
+    auto close_connection = [&](uint64_t id) {
+        auto it = connections.find(id);
+        poller.remove(it->second->fd);
+        close(it->second->fd);
+        // queued requests are dropped by the workers, the ones being evaluated when they finish
+        for (auto & req : it->second->pending) {
+            req->cancelled.store(true, std::memory_order_relaxed);
+        }
+        connections.erase(it);
+        io_metrics.n_open.fetch_sub(1, std::memory_order_relaxed);
+    };
+
+    // POLLIN is only requested while the connection may send more requests,
+    // POLLOUT only while it has responses the socket didn't take
+    auto update_events = [&](server_connection & conn) {
+        const bool want_read = !conn.eof && conn.pending.size() < SERVER_MAX_PENDING;
+        const uint32_t events = (want_read ? POLLIN : 0) | (conn.want_write ? POLLOUT : 0);
+        if (events != conn.events) {
+            poller.modify(conn.fd, conn.id, events);
+            conn.events = events;
+        }
+    };
+
+    // Queues the buffered requests and sends the finished responses, until sending makes no room
+    // for more buffered requests. Returns false once the connection is to be closed
+    auto service = [&](server_connection & conn) {
+        size_t n_in;
+        do {
+            n_in = conn.in.size();
+            if (!server_parse(conn, queue, n_max_request_texts, io_metrics) || !server_flush(conn, io_metrics)) {
+                return false;
+            }
+        } while (conn.in.size() != n_in && conn.pending.size() < SERVER_MAX_PENDING);
+        update_events(conn);
+        // a half-closed connection is done once its last response went out
+        return !(conn.eof && conn.pending.empty());
+    };
+
+    std::vector<server_poller::event> events;
+    std::vector<char> buffer(1 << 16);
+    while (true) {
+        if (!poller.wait(events)) {
+            std::cerr << "Waiting for the sockets failed" << std::endl;
+            break;
+        }
+
+        for (const auto & event : events) {
+            const uint64_t id = event.id;
+
+            if (id == LISTEN_ID) {
+                int fd;
+                while ((fd = accept(server_fd, nullptr, nullptr)) >= 0) {
+                    if (!server_set_nonblocking(fd)) {
+                        close(fd);
+                        continue;
+                    }
+                    const int nodelay = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+                    if (send(fd, (const char *) &n_embd, sizeof(int), MSG_NOSIGNAL) != sizeof(int)) {
+                        close(fd);
+                        continue;
+                    }
+                    auto conn = std::make_unique<server_connection>();
+                    conn->fd = fd;
+                    conn->id = next_id++;
+                    poller.add(fd, conn->id, POLLIN);
+                    connections.emplace(conn->id, std::move(conn));
+                    io_metrics.n_accepted.fetch_add(1, std::memory_order_relaxed);
+                    io_metrics.n_open.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            if (id == EVENT_ID) {
+                for (uint64_t conn_id : completions.take()) {
+                    auto it = connections.find(conn_id);
+                    if (it != connections.end() && !service(*it->second)) {
+                        close_connection(conn_id);
+                    }
+                }
+                continue;
+            }
+
+            auto it = connections.find(id);
+            if (it == connections.end()) {
+                continue;
+            }
+            server_connection & conn = *it->second;
+
+            // connections with too many requests in flight aren't read, unread data stays in the socket
+            // and the client blocks once its buffers are full
+            bool ok = (event.events & (POLLHUP | POLLERR)) == 0;
+            if (ok && (event.events & POLLIN) && !conn.eof && conn.pending.size() < SERVER_MAX_PENDING) {
+                while (conn.in.size() < sizeof(server_frame_header) + SERVER_MAX_FRAME_SIZE) {
+                    const ssize_t n = read(conn.fd, buffer.data(), buffer.size());
+                    if (n > 0) {
+                        conn.in.append(buffer.data(), n);
+                        continue;
+                    }
+                    // on EOF the requests already received are still answered
+                    if (n == 0) {
+                        conn.eof = true;
+                    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                        ok = false;
+                    }
+                    break;
+                }
+            }
+            if (!ok || !service(conn)) {
+                close_connection(id);
             }
-            std::vector<float> embeddings = std::vector<float>(n_embd);
-            bert_encode(bctx, params.n_threads, string_in.data(), embeddings.data());
-            send_floats(new_socket, embeddings);
         }
-        close(new_socket);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.stop = true;
+    }
+    queue.cv.notify_all();
+    for (auto & worker : workers) {
+        worker.join();
+    }
+    if (metrics_fd >= 0) {
+        shutdown(metrics_fd, SHUT_RDWR);
+        metrics_thread.join();
+        close(metrics_fd);
     }
     close(server_fd);
-#if WIN32
-    WSACleanup();
-#endif
+    bert_free(bctx);
     return 0;
 }
@@ -0,0 +1,119 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Encodes the same texts from several threads that share one model, each on its own bert_state,
+// and checks that every thread gets the embeddings of a single threaded run. The second round
+// shares the embedding cache between the threads.
+// Build with -DBERT_SANITIZE_THREAD=ON to check it for data races.
+
+static const char * texts[] = {
+    "Québec",
+    "QUEBEC",
+    "cheap flights to helsinki",
+    "I'm going to the store to buy 3 apples and a banana!",
+    "The time is 2:30 p.m. and it's partly cloudy outside. I'll be back soon, so don't go anywhere.",
+    "int stack[1000], top = -1;",
+};
+static const int n_texts = sizeof(texts) / sizeof(texts[0]);
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+    params.n_threads = 2;
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    bert_ctx * bctx;
+
+    // load the model
+    {
+        if ((bctx = bert_load_from_file(params.model)) == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+    }
+
+    const int n_embd = bert_n_embd(bctx);
+    const int n_workers = 4;
+    const int n_iter = 8;
+
+    std::vector<float> expected(n_texts * n_embd);
+    {
+        std::vector<float *> embeddings(n_texts);
+        for (int i = 0; i < n_texts; i++) {
+            embeddings[i] = expected.data() + i * n_embd;
+        }
+        bert_encode_batch(bctx, 1, n_texts, n_texts, texts, embeddings.data());
+    }
+
+    std::atomic<int> n_failed{0};
+    auto run_workers = [&] {
+        std::vector<std::thread> workers;
+        for (int w = 0; w < n_workers; w++) {
+            workers.emplace_back([&, w] {
+                bert_state * state = bert_state_new(bctx);
+                std::vector<float> result(n_texts * n_embd);
+                std::vector<float *> embeddings(n_texts);
+                for (int i = 0; i < n_texts; i++) {
+                    embeddings[i] = result.data() + i * n_embd;
+                }
+
+                for (int it = 0; it < n_iter; it++) {
+                    // alternate between batched and one by one so the states build different graphs
+                    if ((it + w) % 2 == 0) {
+                        bert_state_encode_batch(state, params.n_threads, n_texts, n_texts, texts, embeddings.data());
+                    } else {
+                        for (int i = 0; i < n_texts; i++) {
+                            bert_state_encode(state, params.n_threads, texts[i], embeddings[i]);
+                        }
+                    }
+
+                    for (int i = 0; i < n_texts * n_embd; i++) {
+                        if (std::fabs(result[i] - expected[i]) > 1e-4f) {
+                            fprintf(stderr, "worker %d, iteration %d: embedding %d differs at %d: %f != %f\n",
+                                    w, it, i / n_embd, i % n_embd, result[i], expected[i]);
+                            n_failed++;
+                            break;
+                        }
+                    }
+                }
+
+                bert_state_free(state);
+            });
+        }
+        for (auto & worker : workers) {
+            worker.join();
+        }
+    };
+
+    run_workers();
+
+    bert_set_embedding_cache_size(bctx, 1024 * 1024);
+    run_workers();
+    const bert_embedding_cache_stats cache_stats = bert_get_embedding_cache_stats(bctx);
+    if (cache_stats.n_hits == 0) {
+        fprintf(stderr, "embedding cache: no hits\n");
+        n_failed++;
+    }
+
+    bert_free(bctx);
+
+    if (n_failed > 0) {
+        printf("concurrency test failed: %d mismatches\n", n_failed.load());
+        return 1;
+    }
+    printf("Success, %d threads x %d iterations\n", n_workers, n_iter);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <cmath>
+#include <vector>
+
+// Encodes texts with an empty embedding store, then with a second context that opens the same store
+// like a restarted process would, and checks that it reads every embedding back without evaluating.
+
+static const char * texts[] = {
+    "Québec",
+    "cheap flights to helsinki",
+    "I'm going to the store to buy 3 apples and a banana!",
+    "The time is 2:30 p.m. and it's partly cloudy outside. I'll be back soon, so don't go anywhere.",
+    "int stack[1000], top = -1;",
+};
+static const int n_texts = sizeof(texts) / sizeof(texts[0]);
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    bert_params params;
+    params.model = "models/all-MiniLM-L6-v2/ggml-model-q4_0.bin";
+    params.prompt = "embedding-store-test.bin";
+
+    if (bert_params_parse(argc, argv, params) == false) {
+        return 1;
+    }
+
+    // the prompt is the path of the store, it is recreated
+    unlink(params.prompt);
+
+    std::vector<float> result[2];
+    bert_embedding_store_stats stats[2];
+    for (int run = 0; run < 2; run++) {
+        bert_ctx * bctx = bert_load_from_file(params.model);
+        if (bctx == nullptr) {
+            fprintf(stderr, "%s: failed to load model from '%s'\n", __func__, params.model);
+            return 1;
+        }
+        if (!bert_set_embedding_store(bctx, params.prompt, 1024 * 1024)) {
+            return 1;
+        }
+
+        const int n_embd = bert_n_embd(bctx);
+        result[run].resize(n_texts * n_embd);
+        std::vector<float *> embeddings(n_texts);
+        for (int i = 0; i < n_texts; i++) {
+            embeddings[i] = result[run].data() + i * n_embd;
+        }
+        bert_encode_batch(bctx, params.n_threads, n_texts, n_texts, texts, embeddings.data());
+        stats[run] = bert_get_embedding_store_stats(bctx);
+
+        bert_free(bctx);
+    }
+    unlink(params.prompt);
+
+    int n_failed = 0;
+    if (stats[0].n_appends != n_texts || stats[1].n_hits != n_texts || stats[1].n_appends != 0) {
+        fprintf(stderr, "unexpected store counters: %lld appends, then %lld hits and %lld appends\n",
+                (long long) stats[0].n_appends, (long long) stats[1].n_hits, (long long) stats[1].n_appends);
+        n_failed++;
+    }
+    for (size_t i = 0; i < result[0].size(); i++) {
+        if (result[0][i] != result[1][i]) {
+            fprintf(stderr, "stored embedding differs at %zu: %f != %f\n", i, result[1][i], result[0][i]);
+            n_failed++;
+            break;
+        }
+    }
+
+    if (n_failed > 0) {
+        printf("embedding store test failed\n");
+        return 1;
+    }
+    printf("Success, %d embeddings read back from the store\n", n_texts);
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "bert.h"
+#include "ggml.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Writes a small legacy (unversioned) model with random weights in the state_dict order of the old
+// convert script, converts it with quantize and checks that both files load and give similar embeddings.
+//
+// usage: test_quantize_legacy [path to quantize], by default the quantize next to this binary
+
+static const int32_t n_vocab = 128;
+static const int32_t n_max_tokens = 32;
+static const int32_t n_embd = 64;
+static const int32_t n_intermediate = 128;
+static const int32_t n_head = 2;
+static const int32_t n_layer = 2;
+
+static const char * texts[] = {
+    "tok7 tok8 tok9",
+    "tok100 tok3 tok120 tok42 tok42",
+    "tok5 tok64 tok99",
+};
+static const int n_texts = sizeof(texts) / sizeof(texts[0]);
+
+static void write_i32(FILE * f, int32_t v) {
+    fwrite(&v, sizeof(v), 1, f);
+}
+
+static bool write_legacy_model(const char * fname) {
+    FILE * f = fopen(fname, "wb");
+    if (!f) {
+        return false;
+    }
+    write_i32(f, 0x67676d6c); // "ggml"
+    for (int32_t v : { n_vocab, n_max_tokens, n_embd, n_intermediate, n_head, n_layer, 0 }) {
+        write_i32(f, v);
+    }
+    for (int i = 0; i < n_vocab; i++) {
+        const std::string word = "tok" + std::to_string(i);
+        write_i32(f, word.size());
+        fwrite(word.data(), 1, word.size(), f);
+    }
+
+    // name and {ne0, ne1} or {ne0} for 1d tensors
+    std::vector<std::pair<std::string, std::vector<int32_t>>> tensors = {
+        { "embeddings.word_embeddings.weight", { n_embd, n_vocab } },
+        { "embeddings.position_embeddings.weight", { n_embd, n_max_tokens } },
+        { "embeddings.token_type_embeddings.weight", { n_embd, 2 } },
+        { "embeddings.LayerNorm.weight", { n_embd } },
+        { "embeddings.LayerNorm.bias", { n_embd } },
+    };
+    for (int l = 0; l < n_layer; l++) {
+        const std::string p = "encoder.layer." + std::to_string(l) + ".";
+        for (const char * m : { "query", "key", "value" }) {
+            tensors.push_back({ p + "attention.self." + m + ".weight", { n_embd, n_embd } });
+            tensors.push_back({ p + "attention.self." + m + ".bias", { n_embd } });
+        }
+        tensors.push_back({ p + "attention.output.dense.weight", { n_embd, n_embd } });
+        tensors.push_back({ p + "attention.output.dense.bias", { n_embd } });
+        tensors.push_back({ p + "attention.output.LayerNorm.weight", { n_embd } });
+        tensors.push_back({ p + "attention.output.LayerNorm.bias", { n_embd } });
+        tensors.push_back({ p + "intermediate.dense.weight", { n_embd, n_intermediate } });
+        tensors.push_back({ p + "intermediate.dense.bias", { n_intermediate } });
+        tensors.push_back({ p + "output.dense.weight", { n_intermediate, n_embd } });
+        tensors.push_back({ p + "output.dense.bias", { n_embd } });
+        tensors.push_back({ p + "output.LayerNorm.weight", { n_embd } });
+        tensors.push_back({ p + "output.LayerNorm.bias", { n_embd } });
+    }
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist(0.0f, 0.05f);
+    std::vector<float> data;
+    for (const auto & t : tensors) {
+        const std::string & name = t.first;
+        const std::vector<int32_t> & ne = t.second;
+        write_i32(f, ne.size());
+        write_i32(f, name.size());
+        write_i32(f, 0); // f32
+        for (int32_t n : ne) {
+            write_i32(f, n);
+        }
+        fwrite(name.data(), 1, name.size(), f);
+
+        const bool ln_weight = name.find("LayerNorm.weight") != std::string::npos;
+        data.resize(ne.size() == 2 ? ne[0] * ne[1] : ne[0]);
+        for (float & x : data) {
+            x = (ln_weight ? 1.0f : 0.0f) + dist(rng);
+        }
+        fwrite(data.data(), sizeof(float), data.size(), f);
+    }
+    return fclose(f) == 0;
+}
+
+static bool encode(const char * fname, std::vector<float> & result) {
+    bert_ctx * bctx = bert_load_from_file(fname);
+    if (bctx == nullptr) {
+        fprintf(stderr, "failed to load model from '%s'\n", fname);
+        return false;
+    }
+    result.resize(n_texts * n_embd);
+    for (int i = 0; i < n_texts; i++) {
+        bert_encode(bctx, 1, texts[i], result.data() + i * n_embd);
+    }
+    bert_free(bctx);
+    return true;
+}
+
+int main(int argc, char ** argv) {
+    ggml_time_init();
+
+    std::string quantize;
+    if (argc > 1) {
+        quantize = argv[1];
+    } else {
+        const std::string self = argv[0];
+        const size_t slash = self.find_last_of('/');
+        quantize = (slash == std::string::npos ? std::string(".") : self.substr(0, slash)) + "/quantize";
+    }
+
+    const char * fname_legacy = "test-legacy-model-f32.bin";
+    const char * fname_q4_0 = "test-legacy-model-q4_0.bin";
+    if (!write_legacy_model(fname_legacy)) {
+        fprintf(stderr, "failed to write '%s'\n", fname_legacy);
+        return 1;
+    }
+
+    const std::string cmd = quantize + " " + fname_legacy + " " + fname_q4_0 + " 2 > /dev/null";
+    if (system(cmd.c_str()) != 0) {
+        fprintf(stderr, "'%s' failed\n", cmd.c_str());
+        return 1;
+    }
+
+    std::vector<float> result_legacy;
+    std::vector<float> result_q4_0;
+    const bool ok = encode(fname_legacy, result_legacy) && encode(fname_q4_0, result_q4_0);
+    unlink(fname_legacy);
+    unlink(fname_q4_0);
+    if (!ok) {
+        return 1;
+    }
+
+    // the embeddings are normalized, a mixed up q, k or v would leave them far apart
+    int n_failed = 0;
+    for (int i = 0; i < n_texts; i++) {
+        double dot = 0.0;
+        for (int j = 0; j < n_embd; j++) {
+            dot += result_legacy[i * n_embd + j] * result_q4_0[i * n_embd + j];
+        }
+        if (!(dot > 0.9)) {
+            fprintf(stderr, "'%s': cosine similarity of the legacy and the quantized model is %f\n", texts[i], dot);
+            n_failed++;
+        }
+    }
+
+    if (n_failed > 0) {
+        printf("legacy quantize test failed\n");
+        return 1;
+    }
+    printf("Success, the legacy model and its q4_0 conversion agree on %d texts\n", n_texts);
+
+    return 0;
+}
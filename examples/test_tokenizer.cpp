@@ -39,6 +39,17 @@ void tokenizer_test(bert_ctx * ctx, const std::string& input, const std::vector<
     }
 }
 
+// Expects input to give the tokens of reference. The references are spelled so that the BertNormalizer and
+// BertPreTokenizer of HF tokenizers split them into the same words as the input, so this holds for any vocab
+void tokenizer_test_same(bert_ctx * ctx, const std::string& input, const std::string& reference) {
+    int N = bert_n_max_tokens(ctx);
+    std::vector<bert_vocab_id> expected(N);
+    int n_tokens;
+    bert_tokenize(ctx, reference.c_str(), expected.data(), &n_tokens, N);
+    expected.resize(n_tokens);
+    tokenizer_test(ctx, input, expected);
+}
+
 
 
 int main(int argc, char ** argv) {
@@ -71,4 +82,34 @@ int main(int argc, char ** argv) {
     tokenizer_test(bctx, "syömme \t  täällä    tänään", {101, 25353, 5358, 4168, 11937, 25425, 9092, 14634, 102});
     tokenizer_test(bctx, "I'm going to the store to buy 3 apples and a banana! You're welcome to come along if you'd like. The time is 2:30 p.m. and it's partly cloudy outside. I'll be back soon, so don't go anywhere.", {101, 1045, 1005, 1049, 2183, 2000, 1996, 3573, 2000, 4965, 1017, 18108, 1998, 1037, 15212, 999, 2017, 1005, 2128, 6160, 2000, 2272, 2247, 2065, 2017, 1005, 1040, 2066, 1012, 1996, 2051, 2003, 1016, 1024, 2382, 1052, 1012, 1049, 1012, 1998, 2009, 1005, 1055, 6576, 24706, 2648, 1012, 1045, 1005, 2222, 2022, 2067, 2574, 1010, 2061, 2123, 1005, 1056, 2175, 5973, 1012, 102});
     tokenizer_test(bctx, "\"5 2 + 3 * 4 -\"; int stack[1000], top = -1; int calculate(int a, int b, char operator) { return operator == '+' ? a + b : operator == '-' ? a - b : operator == '*' ? a * b : a / b; } void push(int x) { stack[++top] = x; } int pop() { return stack[top--]; } int evaluatePostfix(char* expression) { for (int i = 0; expression[i]; i++) { if (isdigit(expression[i])) push(expression[i] - '0'); else { int a = pop(), b = pop(); push(calculate(b, a, expression[i])); } } return pop(); } int result = evaluatePostfix(input);", {101, 1000, 1019, 1016, 1009, 1017, 1008, 1018, 1011, 1000, 1025, 20014, 9991, 1031, 6694, 1033, 1010, 2327, 1027, 1011, 1015, 1025, 20014, 18422, 1006, 20014, 1037, 1010, 20014, 1038, 1010, 25869, 6872, 1007, 1063, 2709, 6872, 1027, 1027, 1005, 1009, 1005, 1029, 1037, 1009, 1038, 1024, 6872, 1027, 1027, 1005, 1011, 1005, 1029, 1037, 1011, 1038, 1024, 6872, 1027, 1027, 1005, 1008, 1005, 1029, 1037, 1008, 1038, 1024, 1037, 1013, 1038, 1025, 1065, 11675, 5245, 1006, 20014, 1060, 1007, 1063, 9991, 1031, 1009, 1009, 2327, 1033, 1027, 1060, 1025, 1065, 20014, 3769, 1006, 1007, 1063, 2709, 9991, 1031, 2327, 1011, 1011, 1033, 1025, 1065, 20014, 16157, 19894, 8873, 2595, 1006, 25869, 1008, 3670, 1007, 1063, 2005, 1006, 20014, 1045, 1027, 1014, 1025, 3670, 1031, 1045, 1033, 1025, 1045, 1009, 1009, 1007, 1063, 2065, 1006, 2003, 4305, 23806, 1006, 3670, 1031, 1045, 1033, 1007, 1007, 5245, 1006, 3670, 1031, 1045, 1033, 1011, 1005, 1014, 1005, 1007, 1025, 2842, 1063, 20014, 1037, 1027, 3769, 1006, 1007, 1010, 1038, 1027, 3769, 1006, 1007, 1025, 5245, 1006, 18422, 1006, 1038, 1010, 1037, 1010, 3670, 1031, 1045, 1033, 1007, 1007, 1025, 1065, 1065, 2709, 3769, 1006, 1007, 1025, 1065, 20014, 2765, 1027, 16157, 19894, 8873, 2595, 1006, 7953, 1007, 1025, 102});
-}
\ No newline at end of file
+
+    // CJK ideographs are words of their own, other scripts stay in their word
+    tokenizer_test_same(bctx, "我爱北京天安门", "我 爱 北 京 天 安 门");
+    tokenizer_test_same(bctx, "bert模型很好用", "bert 模 型 很 好 用");
+    tokenizer_test_same(bctx, "日本語のテキスト", "日 本 語 のテキスト");
+
+    // unicode punctuation splits words like ASCII punctuation
+    tokenizer_test_same(bctx, "hello，world。", "hello ， world 。");
+    tokenizer_test_same(bctx, "«bonjour» ¿que?", "« bonjour » ¿ que ?");
+    tokenizer_test_same(bctx, "wait—what…", "wait — what …");
+    tokenizer_test_same(bctx, "「引用」", "「 引 用 」");
+
+    // invalid UTF-8 is dropped and separates words, HF tokenizers only take valid text so this has no reference there
+    tokenizer_test_same(bctx, "abc\xff" "def", "abc def");
+    tokenizer_test_same(bctx, "caf\xc3", "caf");
+    tokenizer_test_same(bctx, "\xe4\xb8 text \xf0\x9f", "text");
+    tokenizer_test_same(bctx, "\xc0\xaf" "etc", "etc");
+
+    // greek and cyrillic are lowercased, accents and combining marks are removed
+    tokenizer_test_same(bctx, "ΑΘΗΝΑ", "αθηνα");
+    tokenizer_test_same(bctx, "Αθήνα Ελλάδα", "αθηνα ελλαδα");
+    tokenizer_test_same(bctx, "МОСКВА", "москва");
+    tokenizer_test_same(bctx, "Ёлка Йод", "елка иод");
+    tokenizer_test_same(bctx, "Crème Brûlée", "creme brulee");
+    tokenizer_test_same(bctx, u8"cafe\u0301 n\u0303o\u0308", "cafe no");
+    tokenizer_test_same(bctx, "Øre Straße", "øre straße");
+
+    // hangul syllables decompose into their jamo
+    tokenizer_test_same(bctx, "한국어", u8"\u1112\u1161\u11ab\u1100\u116e\u11a8\u110b\u1165");
+    tokenizer_test_same(bctx, "서울", u8"\u1109\u1165\u110b\u116e\u11af");
+}
@@ -61,11 +61,50 @@ list_vars = model.state_dict()
 for name in list_vars.keys():
     print(name, list_vars[name].shape, list_vars[name].dtype)
 
+# q, k and v of each layer are stored as one tensor, the model uses them fused
+def fuse_qkv(list_vars):
+    fused = {}
+    for name in list_vars.keys():
+        if name in ['embeddings.position_ids', 'pooler.dense.weight', 'pooler.dense.bias']:
+            continue
+        if '.attention.self.key.' in name or '.attention.self.value.' in name:
+            continue
+        if '.attention.self.query.' in name:
+            parts = [list_vars[name.replace('.query.', '.' + p + '.')] for p in ['query', 'key', 'value']]
+            fused[name.replace('.query.', '.qkv.')] = torch.cat(parts, dim=0)
+        else:
+            fused[name] = list_vars[name]
+    return fused
+
+tensors = []
+for name, var in fuse_qkv(list_vars).items():
+    data = var.squeeze().numpy()
+    print("Processing variable: " + name + " with shape: ", data.shape)
+
+    n_dims = len(data.shape);
+
+    # ftype == 0 -> float32, ftype == 1 -> float16
+    if ftype == 1 and name[-7:] == ".weight" and n_dims == 2:
+            print("  Converting to float16")
+            data = data.astype(np.float16)
+            l_type = 1
+    else:
+        data = data.astype(np.float32)
+        l_type = 0
+
+    tensors.append((name, data, l_type))
+
+# see the description of the file format in bert.cpp
+ALIGNMENT = 32
+
+def align(offset):
+    return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
 fout = open(fname_out, "wb")
 
 print(hparams)
 
-fout.write(struct.pack("i", 0x67676d6c)) # magic: ggml in hex
+fout.write(struct.pack("IIII", 0x67676266, 1, ALIGNMENT, len(tensors))) # magic: ggbf in hex, version, alignment, n_tensors
 fout.write(struct.pack("i", hparams["vocab_size"]))
 fout.write(struct.pack("i", hparams["max_position_embeddings"]))
 fout.write(struct.pack("i", hparams["hidden_size"]))
@@ -81,30 +120,22 @@ for i in range(hparams["vocab_size"]):
     fout.write(struct.pack("i", len(data)))
     fout.write(data)
 
-for name in list_vars.keys():
-    data = list_vars[name].squeeze().numpy()
-    if name in ['embeddings.position_ids', 'pooler.dense.weight', 'pooler.dense.bias']:
-        continue
-    print("Processing variable: " + name + " with shape: ", data.shape)
-
-    n_dims = len(data.shape);
-
-    # ftype == 0 -> float32, ftype == 1 -> float16
-    if ftype == 1 and name[-7:] == ".weight" and n_dims == 2:
-            print("  Converting to float16")
-            data = data.astype(np.float16)
-            l_type = 1
-    else:
-        l_type = 0
-
-    # header
+# tensor directory, offsets are from the start of the data
+offset = 0
+for name, data, l_type in tensors:
+    n_dims = len(data.shape)
     str = name.encode('utf-8')
-    fout.write(struct.pack("iii", n_dims, len(str), l_type))
+    fout.write(struct.pack("i", len(str)))
+    fout.write(str)
+    fout.write(struct.pack("ii", l_type, n_dims))
     for i in range(n_dims):
         fout.write(struct.pack("i", data.shape[n_dims - 1 - i]))
-    fout.write(str);
+    fout.write(struct.pack("QQ", offset, data.nbytes))
+    offset = align(offset + data.nbytes)
 
-    # data
+# data
+for name, data, l_type in tensors:
+    fout.write(bytes(align(fout.tell()) - fout.tell()))
     data.tofile(fout)
 
 fout.close()
@@ -23,6 +23,36 @@ struct bert_hparams
     int32_t f16 = 1;
 };
 
+// model file format, see bert.cpp
+static const uint32_t BERT_FILE_MAGIC_LEGACY = 0x67676d6c; // "ggml"
+static const uint32_t BERT_FILE_MAGIC = 0x67676266;        // "ggbf"
+static const uint32_t BERT_FILE_VERSION = 1;
+static const uint32_t BERT_FILE_ALIGNMENT = 32;
+
+struct bert_file_tensor {
+    std::string name;
+    int32_t ftype;
+    int32_t n_dims;
+    int32_t ne[2];
+    size_t size;
+    size_t offset;              // of the output tensor, from the start of the data
+    std::vector<size_t> parts;  // offsets in the input file, the data is these equally sized parts one after another
+};
+
+static size_t bert_ftype_size(int32_t ftype, size_t nelements) {
+    switch (ftype) {
+        case 0: return nelements * sizeof(float);
+        case 1: return nelements * sizeof(ggml_fp16_t);
+        case 2: return nelements * ggml_type_size(GGML_TYPE_Q4_0) / ggml_blck_size(GGML_TYPE_Q4_0);
+        case 3: return nelements * ggml_type_size(GGML_TYPE_Q4_1) / ggml_blck_size(GGML_TYPE_Q4_1);
+        default: return 0;
+    }
+}
+
+static size_t bert_align(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
 // quantize a model
 bool bert_model_quantize(const std::string & fname_inp, const std::string & fname_out, int itype) {
     ggml_type type = GGML_TYPE_Q4_1;
@@ -52,16 +82,25 @@ bool bert_model_quantize(const std::string & fname_inp, const std::string & fnam
         return false;
     }
 
-    // verify magic
+    // verify magic, legacy files are converted to the versioned format
+    uint32_t version = 0;
+    uint32_t alignment = 1;
+    uint32_t n_tensors = 0;
     {
         uint32_t magic;
         finp.read((char *) &magic, sizeof(magic));
-        if (magic != 0x67676d6c) {
+        if (magic == BERT_FILE_MAGIC) {
+            finp.read((char *) &version,   sizeof(version));
+            finp.read((char *) &alignment, sizeof(alignment));
+            finp.read((char *) &n_tensors, sizeof(n_tensors));
+            if (version > BERT_FILE_VERSION || alignment == 0) {
+                fprintf(stderr, "%s: unsupported model file '%s' (version %u)\n", __func__, fname_inp.c_str(), version);
+                return false;
+            }
+        } else if (magic != BERT_FILE_MAGIC_LEGACY) {
             fprintf(stderr, "%s: invalid model file '%s' (bad magic)\n", __func__, fname_inp.c_str());
             return false;
         }
-
-        fout.write((char *) &magic, sizeof(magic));
     }
 
     bert_hparams hparams;
@@ -84,6 +123,13 @@ bool bert_model_quantize(const std::string & fname_inp, const std::string & fnam
         printf("%s: n_layer = %d\n", __func__, hparams.n_layer);
         printf("%s: f16     = %d\n", __func__, hparams.f16);
 
+        // n_tensors is filled in once the tensors are known
+        const uint32_t magic = BERT_FILE_MAGIC;
+        fout.write((char *) &magic, sizeof(magic));
+        fout.write((char *) &BERT_FILE_VERSION, sizeof(BERT_FILE_VERSION));
+        fout.write((char *) &BERT_FILE_ALIGNMENT, sizeof(BERT_FILE_ALIGNMENT));
+        fout.write((char *) &n_tensors, sizeof(n_tensors));
+
         fout.write((char *) &hparams.n_vocab, sizeof(hparams.n_vocab));
         fout.write((char *) &hparams.n_max_tokens,   sizeof(hparams.n_max_tokens));
         fout.write((char *) &hparams.n_embd,  sizeof(hparams.n_embd));
@@ -109,98 +155,215 @@ bool bert_model_quantize(const std::string & fname_inp, const std::string & fnam
         }
     }
 
-    // load weights
-    {
-        size_t total_size_org = 0;
-        size_t total_size_new = 0;
-
-        std::vector<float> work;
-
-        std::vector<uint8_t>     data_u8;
-        std::vector<ggml_fp16_t> data_f16;
-        std::vector<float>       data_f32;
-
-        std::vector<int64_t> hist_all(1 << 4, 0);
-
+    // list the input tensors
+    std::vector<bert_file_tensor> tensors;
+    if (version == 0) {
         while (true) {
-            int32_t n_dims;
+            bert_file_tensor t;
             int32_t length;
-            int32_t ftype;
 
-            finp.read(reinterpret_cast<char *>(&n_dims), sizeof(n_dims));
+            finp.read(reinterpret_cast<char *>(&t.n_dims), sizeof(t.n_dims));
             finp.read(reinterpret_cast<char *>(&length), sizeof(length));
-            finp.read(reinterpret_cast<char *>(&ftype),  sizeof(ftype));
+            finp.read(reinterpret_cast<char *>(&t.ftype),  sizeof(t.ftype));
 
             if (finp.eof()) {
                 break;
             }
 
             int32_t nelements = 1;
-            int32_t ne[2] = { 1, 1 };
-            for (int i = 0; i < n_dims; ++i) {
-                finp.read (reinterpret_cast<char *>(&ne[i]), sizeof(ne[i]));
-                nelements *= ne[i];
+            t.ne[0] = t.ne[1] = 1;
+            for (int i = 0; i < t.n_dims; ++i) {
+                finp.read (reinterpret_cast<char *>(&t.ne[i]), sizeof(t.ne[i]));
+                nelements *= t.ne[i];
             }
 
-            std::string name(length, 0);
-            finp.read (&name[0], length);
+            t.name.resize(length);
+            finp.read (&t.name[0], length);
 
-            {
-                static const char * ftype_str[] = { "f32", "f16", "q4_0", "q4_1", };
-                printf("%48s - [%5d, %5d], type = %6s ", name.data(), ne[0], ne[1], ftype_str[ftype]);
+            t.parts = { (size_t) finp.tellg() };
+            t.size = bert_ftype_size(t.ftype, nelements);
+            finp.seekg(t.size, std::ios::cur);
+
+            tensors.push_back(t);
+        }
+        finp.clear();
+
+        // fuse q, k and v in place of q, key and value are dropped. Legacy files are in state_dict order
+        // (query.weight, query.bias, key.weight, ...) so they are looked up by name
+        std::map<std::string, size_t> index;
+        for (size_t i = 0; i < tensors.size(); i++) {
+            index[tensors[i].name] = i;
+        }
+        std::vector<bool> dropped(tensors.size(), false);
+        for (size_t i = 0; i < tensors.size(); i++) {
+            const std::string name = tensors[i].name;
+            const size_t pos = name.find(".attention.self.query.");
+            if (pos == std::string::npos) {
+                continue;
             }
+            const std::string suffix = name.substr(pos + strlen(".attention.self.query."));
+            const std::string prefix = name.substr(0, pos);
+            const auto k = index.find(prefix + ".attention.self.key." + suffix);
+            const auto v = index.find(prefix + ".attention.self.value." + suffix);
+            if (k == index.end() || v == index.end() ||
+                tensors[k->second].size != tensors[i].size || tensors[v->second].size != tensors[i].size ||
+                tensors[k->second].ftype != tensors[i].ftype || tensors[v->second].ftype != tensors[i].ftype) {
+                fprintf(stderr, "%s: missing or mismatched key and value for '%s'\n", __func__, name.c_str());
+                return false;
+            }
+            bert_file_tensor & t = tensors[i];
+            t.name = prefix + ".attention.self.qkv." + suffix;
+            t.ne[t.n_dims - 1] *= 3;
+            t.size *= 3;
+            t.parts = { t.parts[0], tensors[k->second].parts[0], tensors[v->second].parts[0] };
+            dropped[k->second] = true;
+            dropped[v->second] = true;
+        }
+        std::vector<bert_file_tensor> fused;
+        for (size_t i = 0; i < tensors.size(); i++) {
+            if (!dropped[i]) {
+                fused.push_back(std::move(tensors[i]));
+            }
+        }
+        tensors.swap(fused);
+    } else {
+        for (uint32_t i = 0; i < n_tensors; i++) {
+            bert_file_tensor t;
+            uint32_t length;
+            finp.read(reinterpret_cast<char *>(&length), sizeof(length));
+            t.name.resize(length);
+            finp.read(&t.name[0], length);
+            finp.read(reinterpret_cast<char *>(&t.ftype),  sizeof(t.ftype));
+            finp.read(reinterpret_cast<char *>(&t.n_dims), sizeof(t.n_dims));
+            t.ne[0] = t.ne[1] = 1;
+            for (int d = 0; d < t.n_dims; d++) {
+                finp.read(reinterpret_cast<char *>(&t.ne[d]), sizeof(t.ne[d]));
+            }
+            uint64_t offset, size;
+            finp.read(reinterpret_cast<char *>(&offset), sizeof(offset));
+            finp.read(reinterpret_cast<char *>(&size),   sizeof(size));
+            t.parts = { (size_t) offset };
+            t.size = size;
+            tensors.push_back(t);
+        }
+        const size_t data_offset = bert_align(finp.tellg(), alignment);
+        for (auto & t : tensors) {
+            t.parts[0] += data_offset;
+        }
+    }
+    if (!finp) {
+        fprintf(stderr, "%s: failed to read the tensors of '%s'\n", __func__, fname_inp.c_str());
+        return false;
+    }
 
-            // regexes of tensor names to be quantized
-            const std::vector<std::string> k_names = {
-                ".*weight",
-            };
+    // regexes of tensor names to be quantized
+    const std::vector<std::string> k_names = {
+        ".*weight",
+    };
 
-            bool quantize = false;
+    // output tensors, quantize only 2D tensors
+    std::vector<bert_file_tensor> tensors_out = tensors;
+    std::vector<bool> quantize(tensors.size(), false);
+    {
+        size_t offset = 0;
+        for (size_t i = 0; i < tensors.size(); i++) {
+            auto & t = tensors_out[i];
             for (const auto & s : k_names) {
-                if (std::regex_match(name, std::regex(s))) {
-                    quantize = true;
+                if (std::regex_match(t.name, std::regex(s))) {
+                    quantize[i] = true;
                     break;
                 }
             }
+            quantize[i] = quantize[i] && t.n_dims == 2;
 
-            // quantize only 2D tensors
-            quantize &= (n_dims == 2);
-
-            if (quantize) {
-                if (ftype != 0 && ftype != 1) {
-                    fprintf(stderr, "%s: unsupported ftype %d for integer quantization\n", __func__, ftype);
+            if (quantize[i]) {
+                if (t.ftype != 0 && t.ftype != 1) {
+                    fprintf(stderr, "%s: unsupported ftype %d for integer quantization\n", __func__, t.ftype);
                     return false;
                 }
+                t.ftype = itype;
+                t.size = bert_ftype_size(itype, t.ne[0] * t.ne[1]);
+            }
+            t.offset = offset;
+            offset = bert_align(offset + t.size, BERT_FILE_ALIGNMENT);
+        }
+    }
+
+    // write the tensor directory
+    {
+        for (const auto & t : tensors_out) {
+            const uint32_t length = t.name.size();
+            const uint64_t offset = t.offset;
+            const uint64_t size = t.size;
+            fout.write(reinterpret_cast<const char *>(&length), sizeof(length));
+            fout.write(t.name.data(), length);
+            fout.write(reinterpret_cast<const char *>(&t.ftype),  sizeof(t.ftype));
+            fout.write(reinterpret_cast<const char *>(&t.n_dims), sizeof(t.n_dims));
+            for (int i = 0; i < t.n_dims; ++i) {
+                fout.write(reinterpret_cast<const char *>(&t.ne[i]), sizeof(t.ne[i]));
+            }
+            fout.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+            fout.write(reinterpret_cast<const char *>(&size),   sizeof(size));
+        }
+
+        const uint32_t n_tensors_out = tensors_out.size();
+        const size_t end = fout.tellp();
+        fout.seekp(3 * sizeof(uint32_t));
+        fout.write(reinterpret_cast<const char *>(&n_tensors_out), sizeof(n_tensors_out));
+        fout.seekp(end);
+    }
+
+    // load weights
+    {
+        size_t total_size_org = 0;
+        size_t total_size_new = 0;
+
+        std::vector<float> work;
+
+        std::vector<uint8_t>     data_u8;
+        std::vector<ggml_fp16_t> data_f16;
+        std::vector<float>       data_f32;
+
+        std::vector<int64_t> hist_all(1 << 4, 0);
+
+        const size_t data_offset = bert_align(fout.tellp(), BERT_FILE_ALIGNMENT);
+
+        for (size_t it = 0; it < tensors.size(); it++) {
+            const bert_file_tensor & t = tensors[it];
+            const int32_t nelements = t.ne[0] * t.ne[1];
+            const int32_t * ne = t.ne;
+
+            {
+                static const char * ftype_str[] = { "f32", "f16", "q4_0", "q4_1", };
+                printf("%48s - [%5d, %5d], type = %6s ", t.name.data(), ne[0], ne[1], ftype_str[t.ftype]);
+            }
+
+            data_u8.resize(t.size);
+            const size_t part_size = t.size / t.parts.size();
+            for (size_t i = 0; i < t.parts.size(); i++) {
+                finp.seekg(t.parts[i]);
+                finp.read(reinterpret_cast<char *>(data_u8.data()) + i * part_size, part_size);
+            }
+            if (!finp) {
+                fprintf(stderr, "%s: failed to read tensor '%s'\n", __func__, t.name.c_str());
+                return false;
+            }
 
-                if (ftype == 1) {
-                    data_f16.resize(nelements);
-                    finp.read(reinterpret_cast<char *>(data_f16.data()), nelements * sizeof(ggml_fp16_t));
-                    data_f32.resize(nelements);
+            if (quantize[it]) {
+                data_f32.resize(nelements);
+                if (t.ftype == 1) {
+                    const ggml_fp16_t * src = reinterpret_cast<const ggml_fp16_t *>(data_u8.data());
                     for (int i = 0; i < nelements; ++i) {
-                        data_f32[i] = ggml_fp16_to_fp32(data_f16[i]);
+                        data_f32[i] = ggml_fp16_to_fp32(src[i]);
                     }
                 } else {
-                    data_f32.resize(nelements);
-                    finp.read(reinterpret_cast<char *>(data_f32.data()), nelements * sizeof(float));
+                    memcpy(data_f32.data(), data_u8.data(), nelements * sizeof(float));
                 }
-
-                ftype = itype;
-            } else {
-                const int bpe = (ftype == 0) ? sizeof(float) : sizeof(uint16_t);
-
-                data_u8.resize(nelements*bpe);
-                finp.read(reinterpret_cast<char *>(data_u8.data()), nelements * bpe);
             }
 
-            fout.write(reinterpret_cast<char *>(&n_dims), sizeof(n_dims));
-            fout.write(reinterpret_cast<char *>(&length), sizeof(length));
-            fout.write(reinterpret_cast<char *>(&ftype),  sizeof(ftype));
-            for (int i = 0; i < n_dims; ++i) {
-                fout.write(reinterpret_cast<char *>(&ne[i]), sizeof(ne[i]));
-            }
-            fout.write(&name[0], length);
+            fout.seekp(data_offset + tensors_out[it].offset);
 
-            if (quantize) {
+            if (quantize[it]) {
                 printf("quantizing .. ");
                 work.resize(nelements); // for quantization
 
@@ -222,6 +385,7 @@ bool bert_model_quantize(const std::string & fname_inp, const std::string & fnam
                             return false;
                         }
                 }
+                assert(cur_size == tensors_out[it].size);
 
                 fout.write(reinterpret_cast<char *>(work.data()), cur_size);
                 total_size_new += cur_size;
@@ -0,0 +1,96 @@
+# Generates unicode_data.h, the normalization tables of bert_normalize_prompt.
+#
+# Every code point is mapped the way the BERT BasicTokenizer normalizes uncased text:
+# control and format characters are removed, then the character is lowercased,
+# decomposed (NFD) and combining marks (Mn) are removed.
+#
+# usage: python3 scripts/gen-unicode-data.py > unicode_data.h
+
+import sys
+import unicodedata
+
+
+def is_removed(c):
+    cp = ord(c)
+    if cp == 0 or cp == 0xFFFD:
+        return True
+    if c in "\t\n\r":
+        return False
+    return unicodedata.category(c) in ("Cc", "Cf")
+
+
+def normalize(c):
+    if is_removed(c):
+        return ""
+    text = unicodedata.normalize("NFD", c.lower())
+    return "".join(ch for ch in text if unicodedata.category(ch) != "Mn")
+
+
+removed = []
+single = []
+multi = []
+for cp in range(0x80, 0x110000):
+    if 0xD800 <= cp <= 0xDFFF:
+        continue
+    # hangul syllables are decomposed algorithmically
+    if 0xAC00 <= cp <= 0xD7A3:
+        continue
+    c = chr(cp)
+    n = normalize(c)
+    if n == c:
+        continue
+    if n == "":
+        removed.append(cp)
+    elif len(n) == 1:
+        single.append((cp, ord(n)))
+    else:
+        multi.append((cp, n))
+
+# removed code points as ranges
+ranges = []
+for cp in removed:
+    if ranges and ranges[-1][1] + 1 == cp:
+        ranges[-1][1] = cp
+    else:
+        ranges.append([cp, cp])
+
+
+def rows(items, per_row, fmt):
+    out = []
+    for i in range(0, len(items), per_row):
+        out.append("    " + " ".join(fmt(x) for x in items[i:i + per_row]))
+    return "\n".join(out)
+
+
+def c_string(s):
+    return '"' + "".join("\\x%02x" % b for b in s.encode("utf-8")) + '"'
+
+
+print("// Generated by scripts/gen-unicode-data.py from Unicode %s, do not edit" % unicodedata.unidata_version)
+print("// Non-ASCII code points that bert_normalize_prompt changes, except hangul syllables.")
+print("// All tables are sorted by code point.")
+print("")
+print("#pragma once")
+print("")
+print("#include <stdint.h>")
+print("")
+print("// removed: combining marks, control and format characters")
+print("static const uint32_t bert_unicode_removed[][2] = {")
+print(rows(ranges, 6, lambda r: "{0x%05X, 0x%05X}," % (r[0], r[1])))
+print("};")
+print("")
+print("// lowercased and/or stripped of accents to one code point")
+print("static const uint32_t bert_unicode_single[][2] = {")
+print(rows(single, 8, lambda p: "{0x%05X, 0x%05X}," % p))
+print("};")
+print("")
+print("// mapped to several code points")
+print("struct bert_unicode_multi_entry")
+print("{")
+print("    uint32_t cp;")
+print("    const char * utf8;")
+print("};")
+print("")
+print("static const bert_unicode_multi_entry bert_unicode_multi[] = {")
+print(rows(multi, 4, lambda p: "{0x%05X, %s}," % (p[0], c_string(p[1]))))
+print("};")
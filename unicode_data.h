@@ -0,0 +1,474 @@
+// Generated by scripts/gen-unicode-data.py from Unicode 14.0.0, do not edit
+// Non-ASCII code points that bert_normalize_prompt changes, except hangul syllables.
+// All tables are sorted by code point.
+
+#pragma once
+
+#include <stdint.h>
+
+// removed: combining marks, control and format characters
+static const uint32_t bert_unicode_removed[][2] = {
+    {0x00080, 0x0009F}, {0x000AD, 0x000AD}, {0x00300, 0x0036F}, {0x00483, 0x00487}, {0x00591, 0x005BD}, {0x005BF, 0x005BF},
+    {0x005C1, 0x005C2}, {0x005C4, 0x005C5}, {0x005C7, 0x005C7}, {0x00600, 0x00605}, {0x00610, 0x0061A}, {0x0061C, 0x0061C},
+    {0x0064B, 0x0065F}, {0x00670, 0x00670}, {0x006D6, 0x006DD}, {0x006DF, 0x006E4}, {0x006E7, 0x006E8}, {0x006EA, 0x006ED},
+    {0x0070F, 0x0070F}, {0x00711, 0x00711}, {0x00730, 0x0074A}, {0x007A6, 0x007B0}, {0x007EB, 0x007F3}, {0x007FD, 0x007FD},
+    {0x00816, 0x00819}, {0x0081B, 0x00823}, {0x00825, 0x00827}, {0x00829, 0x0082D}, {0x00859, 0x0085B}, {0x00890, 0x00891},
+    {0x00898, 0x0089F}, {0x008CA, 0x00902}, {0x0093A, 0x0093A}, {0x0093C, 0x0093C}, {0x00941, 0x00948}, {0x0094D, 0x0094D},
+    {0x00951, 0x00957}, {0x00962, 0x00963}, {0x00981, 0x00981}, {0x009BC, 0x009BC}, {0x009C1, 0x009C4}, {0x009CD, 0x009CD},
+    {0x009E2, 0x009E3}, {0x009FE, 0x009FE}, {0x00A01, 0x00A02}, {0x00A3C, 0x00A3C}, {0x00A41, 0x00A42}, {0x00A47, 0x00A48},
+    {0x00A4B, 0x00A4D}, {0x00A51, 0x00A51}, {0x00A70, 0x00A71}, {0x00A75, 0x00A75}, {0x00A81, 0x00A82}, {0x00ABC, 0x00ABC},
+    {0x00AC1, 0x00AC5}, {0x00AC7, 0x00AC8}, {0x00ACD, 0x00ACD}, {0x00AE2, 0x00AE3}, {0x00AFA, 0x00AFF}, {0x00B01, 0x00B01},
+    {0x00B3C, 0x00B3C}, {0x00B3F, 0x00B3F}, {0x00B41, 0x00B44}, {0x00B4D, 0x00B4D}, {0x00B55, 0x00B56}, {0x00B62, 0x00B63},
+    {0x00B82, 0x00B82}, {0x00BC0, 0x00BC0}, {0x00BCD, 0x00BCD}, {0x00C00, 0x00C00}, {0x00C04, 0x00C04}, {0x00C3C, 0x00C3C},
+    {0x00C3E, 0x00C40}, {0x00C46, 0x00C48}, {0x00C4A, 0x00C4D}, {0x00C55, 0x00C56}, {0x00C62, 0x00C63}, {0x00C81, 0x00C81},
+    {0x00CBC, 0x00CBC}, {0x00CBF, 0x00CBF}, {0x00CC6, 0x00CC6}, {0x00CCC, 0x00CCD}, {0x00CE2, 0x00CE3}, {0x00D00, 0x00D01},
+    {0x00D3B, 0x00D3C}, {0x00D41, 0x00D44}, {0x00D4D, 0x00D4D}, {0x00D62, 0x00D63}, {0x00D81, 0x00D81}, {0x00DCA, 0x00DCA},
+    {0x00DD2, 0x00DD4}, {0x00DD6, 0x00DD6}, {0x00E31, 0x00E31}, {0x00E34, 0x00E3A}, {0x00E47, 0x00E4E}, {0x00EB1, 0x00EB1},
+    {0x00EB4, 0x00EBC}, {0x00EC8, 0x00ECD}, {0x00F18, 0x00F19}, {0x00F35, 0x00F35}, {0x00F37, 0x00F37}, {0x00F39, 0x00F39},
+    {0x00F71, 0x00F7E}, {0x00F80, 0x00F84}, {0x00F86, 0x00F87}, {0x00F8D, 0x00F97}, {0x00F99, 0x00FBC}, {0x00FC6, 0x00FC6},
+    {0x0102D, 0x01030}, {0x01032, 0x01037}, {0x01039, 0x0103A}, {0x0103D, 0x0103E}, {0x01058, 0x01059}, {0x0105E, 0x01060},
+    {0x01071, 0x01074}, {0x01082, 0x01082}, {0x01085, 0x01086}, {0x0108D, 0x0108D}, {0x0109D, 0x0109D}, {0x0135D, 0x0135F},
+    {0x01712, 0x01714}, {0x01732, 0x01733}, {0x01752, 0x01753}, {0x01772, 0x01773}, {0x017B4, 0x017B5}, {0x017B7, 0x017BD},
+    {0x017C6, 0x017C6}, {0x017C9, 0x017D3}, {0x017DD, 0x017DD}, {0x0180B, 0x0180F}, {0x01885, 0x01886}, {0x018A9, 0x018A9},
+    {0x01920, 0x01922}, {0x01927, 0x01928}, {0x01932, 0x01932}, {0x01939, 0x0193B}, {0x01A17, 0x01A18}, {0x01A1B, 0x01A1B},
+    {0x01A56, 0x01A56}, {0x01A58, 0x01A5E}, {0x01A60, 0x01A60}, {0x01A62, 0x01A62}, {0x01A65, 0x01A6C}, {0x01A73, 0x01A7C},
+    {0x01A7F, 0x01A7F}, {0x01AB0, 0x01ABD}, {0x01ABF, 0x01ACE}, {0x01B00, 0x01B03}, {0x01B34, 0x01B34}, {0x01B36, 0x01B3A},
+    {0x01B3C, 0x01B3C}, {0x01B42, 0x01B42}, {0x01B6B, 0x01B73}, {0x01B80, 0x01B81}, {0x01BA2, 0x01BA5}, {0x01BA8, 0x01BA9},
+    {0x01BAB, 0x01BAD}, {0x01BE6, 0x01BE6}, {0x01BE8, 0x01BE9}, {0x01BED, 0x01BED}, {0x01BEF, 0x01BF1}, {0x01C2C, 0x01C33},
+    {0x01C36, 0x01C37}, {0x01CD0, 0x01CD2}, {0x01CD4, 0x01CE0}, {0x01CE2, 0x01CE8}, {0x01CED, 0x01CED}, {0x01CF4, 0x01CF4},
+    {0x01CF8, 0x01CF9}, {0x01DC0, 0x01DFF}, {0x0200B, 0x0200F}, {0x0202A, 0x0202E}, {0x02060, 0x02064}, {0x02066, 0x0206F},
+    {0x020D0, 0x020DC}, {0x020E1, 0x020E1}, {0x020E5, 0x020F0}, {0x02CEF, 0x02CF1}, {0x02D7F, 0x02D7F}, {0x02DE0, 0x02DFF},
+    {0x0302A, 0x0302D}, {0x03099, 0x0309A}, {0x0A66F, 0x0A66F}, {0x0A674, 0x0A67D}, {0x0A69E, 0x0A69F}, {0x0A6F0, 0x0A6F1},
+    {0x0A802, 0x0A802}, {0x0A806, 0x0A806}, {0x0A80B, 0x0A80B}, {0x0A825, 0x0A826}, {0x0A82C, 0x0A82C}, {0x0A8C4, 0x0A8C5},
+    {0x0A8E0, 0x0A8F1}, {0x0A8FF, 0x0A8FF}, {0x0A926, 0x0A92D}, {0x0A947, 0x0A951}, {0x0A980, 0x0A982}, {0x0A9B3, 0x0A9B3},
+    {0x0A9B6, 0x0A9B9}, {0x0A9BC, 0x0A9BD}, {0x0A9E5, 0x0A9E5}, {0x0AA29, 0x0AA2E}, {0x0AA31, 0x0AA32}, {0x0AA35, 0x0AA36},
+    {0x0AA43, 0x0AA43}, {0x0AA4C, 0x0AA4C}, {0x0AA7C, 0x0AA7C}, {0x0AAB0, 0x0AAB0}, {0x0AAB2, 0x0AAB4}, {0x0AAB7, 0x0AAB8},
+    {0x0AABE, 0x0AABF}, {0x0AAC1, 0x0AAC1}, {0x0AAEC, 0x0AAED}, {0x0AAF6, 0x0AAF6}, {0x0ABE5, 0x0ABE5}, {0x0ABE8, 0x0ABE8},
+    {0x0ABED, 0x0ABED}, {0x0FB1E, 0x0FB1E}, {0x0FE00, 0x0FE0F}, {0x0FE20, 0x0FE2F}, {0x0FEFF, 0x0FEFF}, {0x0FFF9, 0x0FFFB},
+    {0x0FFFD, 0x0FFFD}, {0x101FD, 0x101FD}, {0x102E0, 0x102E0}, {0x10376, 0x1037A}, {0x10A01, 0x10A03}, {0x10A05, 0x10A06},
+    {0x10A0C, 0x10A0F}, {0x10A38, 0x10A3A}, {0x10A3F, 0x10A3F}, {0x10AE5, 0x10AE6}, {0x10D24, 0x10D27}, {0x10EAB, 0x10EAC},
+    {0x10F46, 0x10F50}, {0x10F82, 0x10F85}, {0x11001, 0x11001}, {0x11038, 0x11046}, {0x11070, 0x11070}, {0x11073, 0x11074},
+    {0x1107F, 0x11081}, {0x110B3, 0x110B6}, {0x110B9, 0x110BA}, {0x110BD, 0x110BD}, {0x110C2, 0x110C2}, {0x110CD, 0x110CD},
+    {0x11100, 0x11102}, {0x11127, 0x1112B}, {0x1112D, 0x11134}, {0x11173, 0x11173}, {0x11180, 0x11181}, {0x111B6, 0x111BE},
+    {0x111C9, 0x111CC}, {0x111CF, 0x111CF}, {0x1122F, 0x11231}, {0x11234, 0x11234}, {0x11236, 0x11237}, {0x1123E, 0x1123E},
+    {0x112DF, 0x112DF}, {0x112E3, 0x112EA}, {0x11300, 0x11301}, {0x1133B, 0x1133C}, {0x11340, 0x11340}, {0x11366, 0x1136C},
+    {0x11370, 0x11374}, {0x11438, 0x1143F}, {0x11442, 0x11444}, {0x11446, 0x11446}, {0x1145E, 0x1145E}, {0x114B3, 0x114B8},
+    {0x114BA, 0x114BA}, {0x114BF, 0x114C0}, {0x114C2, 0x114C3}, {0x115B2, 0x115B5}, {0x115BC, 0x115BD}, {0x115BF, 0x115C0},
+    {0x115DC, 0x115DD}, {0x11633, 0x1163A}, {0x1163D, 0x1163D}, {0x1163F, 0x11640}, {0x116AB, 0x116AB}, {0x116AD, 0x116AD},
+    {0x116B0, 0x116B5}, {0x116B7, 0x116B7}, {0x1171D, 0x1171F}, {0x11722, 0x11725}, {0x11727, 0x1172B}, {0x1182F, 0x11837},
+    {0x11839, 0x1183A}, {0x1193B, 0x1193C}, {0x1193E, 0x1193E}, {0x11943, 0x11943}, {0x119D4, 0x119D7}, {0x119DA, 0x119DB},
+    {0x119E0, 0x119E0}, {0x11A01, 0x11A0A}, {0x11A33, 0x11A38}, {0x11A3B, 0x11A3E}, {0x11A47, 0x11A47}, {0x11A51, 0x11A56},
+    {0x11A59, 0x11A5B}, {0x11A8A, 0x11A96}, {0x11A98, 0x11A99}, {0x11C30, 0x11C36}, {0x11C38, 0x11C3D}, {0x11C3F, 0x11C3F},
+    {0x11C92, 0x11CA7}, {0x11CAA, 0x11CB0}, {0x11CB2, 0x11CB3}, {0x11CB5, 0x11CB6}, {0x11D31, 0x11D36}, {0x11D3A, 0x11D3A},
+    {0x11D3C, 0x11D3D}, {0x11D3F, 0x11D45}, {0x11D47, 0x11D47}, {0x11D90, 0x11D91}, {0x11D95, 0x11D95}, {0x11D97, 0x11D97},
+    {0x11EF3, 0x11EF4}, {0x13430, 0x13438}, {0x16AF0, 0x16AF4}, {0x16B30, 0x16B36}, {0x16F4F, 0x16F4F}, {0x16F8F, 0x16F92},
+    {0x16FE4, 0x16FE4}, {0x1BC9D, 0x1BC9E}, {0x1BCA0, 0x1BCA3}, {0x1CF00, 0x1CF2D}, {0x1CF30, 0x1CF46}, {0x1D167, 0x1D169},
+    {0x1D173, 0x1D182}, {0x1D185, 0x1D18B}, {0x1D1AA, 0x1D1AD}, {0x1D242, 0x1D244}, {0x1DA00, 0x1DA36}, {0x1DA3B, 0x1DA6C},
+    {0x1DA75, 0x1DA75}, {0x1DA84, 0x1DA84}, {0x1DA9B, 0x1DA9F}, {0x1DAA1, 0x1DAAF}, {0x1E000, 0x1E006}, {0x1E008, 0x1E018},
+    {0x1E01B, 0x1E021}, {0x1E023, 0x1E024}, {0x1E026, 0x1E02A}, {0x1E130, 0x1E136}, {0x1E2AE, 0x1E2AE}, {0x1E2EC, 0x1E2EF},
+    {0x1E8D0, 0x1E8D6}, {0x1E944, 0x1E94A}, {0xE0001, 0xE0001}, {0xE0020, 0xE007F}, {0xE0100, 0xE01EF},
+};
+
+// lowercased and/or stripped of accents to one code point
+static const uint32_t bert_unicode_single[][2] = {
+    {0x000C0, 0x00061}, {0x000C1, 0x00061}, {0x000C2, 0x00061}, {0x000C3, 0x00061}, {0x000C4, 0x00061}, {0x000C5, 0x00061}, {0x000C6, 0x000E6}, {0x000C7, 0x00063},
+    {0x000C8, 0x00065}, {0x000C9, 0x00065}, {0x000CA, 0x00065}, {0x000CB, 0x00065}, {0x000CC, 0x00069}, {0x000CD, 0x00069}, {0x000CE, 0x00069}, {0x000CF, 0x00069},
+    {0x000D0, 0x000F0}, {0x000D1, 0x0006E}, {0x000D2, 0x0006F}, {0x000D3, 0x0006F}, {0x000D4, 0x0006F}, {0x000D5, 0x0006F}, {0x000D6, 0x0006F}, {0x000D8, 0x000F8},
+    {0x000D9, 0x00075}, {0x000DA, 0x00075}, {0x000DB, 0x00075}, {0x000DC, 0x00075}, {0x000DD, 0x00079}, {0x000DE, 0x000FE}, {0x000E0, 0x00061}, {0x000E1, 0x00061},
+    {0x000E2, 0x00061}, {0x000E3, 0x00061}, {0x000E4, 0x00061}, {0x000E5, 0x00061}, {0x000E7, 0x00063}, {0x000E8, 0x00065}, {0x000E9, 0x00065}, {0x000EA, 0x00065},
+    {0x000EB, 0x00065}, {0x000EC, 0x00069}, {0x000ED, 0x00069}, {0x000EE, 0x00069}, {0x000EF, 0x00069}, {0x000F1, 0x0006E}, {0x000F2, 0x0006F}, {0x000F3, 0x0006F},
+    {0x000F4, 0x0006F}, {0x000F5, 0x0006F}, {0x000F6, 0x0006F}, {0x000F9, 0x00075}, {0x000FA, 0x00075}, {0x000FB, 0x00075}, {0x000FC, 0x00075}, {0x000FD, 0x00079},
+    {0x000FF, 0x00079}, {0x00100, 0x00061}, {0x00101, 0x00061}, {0x00102, 0x00061}, {0x00103, 0x00061}, {0x00104, 0x00061}, {0x00105, 0x00061}, {0x00106, 0x00063},
+    {0x00107, 0x00063}, {0x00108, 0x00063}, {0x00109, 0x00063}, {0x0010A, 0x00063}, {0x0010B, 0x00063}, {0x0010C, 0x00063}, {0x0010D, 0x00063}, {0x0010E, 0x00064},
+    {0x0010F, 0x00064}, {0x00110, 0x00111}, {0x00112, 0x00065}, {0x00113, 0x00065}, {0x00114, 0x00065}, {0x00115, 0x00065}, {0x00116, 0x00065}, {0x00117, 0x00065},
+    {0x00118, 0x00065}, {0x00119, 0x00065}, {0x0011A, 0x00065}, {0x0011B, 0x00065}, {0x0011C, 0x00067}, {0x0011D, 0x00067}, {0x0011E, 0x00067}, {0x0011F, 0x00067},
+    {0x00120, 0x00067}, {0x00121, 0x00067}, {0x00122, 0x00067}, {0x00123, 0x00067}, {0x00124, 0x00068}, {0x00125, 0x00068}, {0x00126, 0x00127}, {0x00128, 0x00069},
+    {0x00129, 0x00069}, {0x0012A, 0x00069}, {0x0012B, 0x00069}, {0x0012C, 0x00069}, {0x0012D, 0x00069}, {0x0012E, 0x00069}, {0x0012F, 0x00069}, {0x00130, 0x00069},
+    {0x00132, 0x00133}, {0x00134, 0x0006A}, {0x00135, 0x0006A}, {0x00136, 0x0006B}, {0x00137, 0x0006B}, {0x00139, 0x0006C}, {0x0013A, 0x0006C}, {0x0013B, 0x0006C},
+    {0x0013C, 0x0006C}, {0x0013D, 0x0006C}, {0x0013E, 0x0006C}, {0x0013F, 0x00140}, {0x00141, 0x00142}, {0x00143, 0x0006E}, {0x00144, 0x0006E}, {0x00145, 0x0006E},
+    {0x00146, 0x0006E}, {0x00147, 0x0006E}, {0x00148, 0x0006E}, {0x0014A, 0x0014B}, {0x0014C, 0x0006F}, {0x0014D, 0x0006F}, {0x0014E, 0x0006F}, {0x0014F, 0x0006F},
+    {0x00150, 0x0006F}, {0x00151, 0x0006F}, {0x00152, 0x00153}, {0x00154, 0x00072}, {0x00155, 0x00072}, {0x00156, 0x00072}, {0x00157, 0x00072}, {0x00158, 0x00072},
+    {0x00159, 0x00072}, {0x0015A, 0x00073}, {0x0015B, 0x00073}, {0x0015C, 0x00073}, {0x0015D, 0x00073}, {0x0015E, 0x00073}, {0x0015F, 0x00073}, {0x00160, 0x00073},
+    {0x00161, 0x00073}, {0x00162, 0x00074}, {0x00163, 0x00074}, {0x00164, 0x00074}, {0x00165, 0x00074}, {0x00166, 0x00167}, {0x00168, 0x00075}, {0x00169, 0x00075},
+    {0x0016A, 0x00075}, {0x0016B, 0x00075}, {0x0016C, 0x00075}, {0x0016D, 0x00075}, {0x0016E, 0x00075}, {0x0016F, 0x00075}, {0x00170, 0x00075}, {0x00171, 0x00075},
+    {0x00172, 0x00075}, {0x00173, 0x00075}, {0x00174, 0x00077}, {0x00175, 0x00077}, {0x00176, 0x00079}, {0x00177, 0x00079}, {0x00178, 0x00079}, {0x00179, 0x0007A},
+    {0x0017A, 0x0007A}, {0x0017B, 0x0007A}, {0x0017C, 0x0007A}, {0x0017D, 0x0007A}, {0x0017E, 0x0007A}, {0x00181, 0x00253}, {0x00182, 0x00183}, {0x00184, 0x00185},
+    {0x00186, 0x00254}, {0x00187, 0x00188}, {0x00189, 0x00256}, {0x0018A, 0x00257}, {0x0018B, 0x0018C}, {0x0018E, 0x001DD}, {0x0018F, 0x00259}, {0x00190, 0x0025B},
+    {0x00191, 0x00192}, {0x00193, 0x00260}, {0x00194, 0x00263}, {0x00196, 0x00269}, {0x00197, 0x00268}, {0x00198, 0x00199}, {0x0019C, 0x0026F}, {0x0019D, 0x00272},
+    {0x0019F, 0x00275}, {0x001A0, 0x0006F}, {0x001A1, 0x0006F}, {0x001A2, 0x001A3}, {0x001A4, 0x001A5}, {0x001A6, 0x00280}, {0x001A7, 0x001A8}, {0x001A9, 0x00283},
+    {0x001AC, 0x001AD}, {0x001AE, 0x00288}, {0x001AF, 0x00075}, {0x001B0, 0x00075}, {0x001B1, 0x0028A}, {0x001B2, 0x0028B}, {0x001B3, 0x001B4}, {0x001B5, 0x001B6},
+    {0x001B7, 0x00292}, {0x001B8, 0x001B9}, {0x001BC, 0x001BD}, {0x001C4, 0x001C6}, {0x001C5, 0x001C6}, {0x001C7, 0x001C9}, {0x001C8, 0x001C9}, {0x001CA, 0x001CC},
+    {0x001CB, 0x001CC}, {0x001CD, 0x00061}, {0x001CE, 0x00061}, {0x001CF, 0x00069}, {0x001D0, 0x00069}, {0x001D1, 0x0006F}, {0x001D2, 0x0006F}, {0x001D3, 0x00075},
+    {0x001D4, 0x00075}, {0x001D5, 0x00075}, {0x001D6, 0x00075}, {0x001D7, 0x00075}, {0x001D8, 0x00075}, {0x001D9, 0x00075}, {0x001DA, 0x00075}, {0x001DB, 0x00075},
+    {0x001DC, 0x00075}, {0x001DE, 0x00061}, {0x001DF, 0x00061}, {0x001E0, 0x00061}, {0x001E1, 0x00061}, {0x001E2, 0x000E6}, {0x001E3, 0x000E6}, {0x001E4, 0x001E5},
+    {0x001E6, 0x00067}, {0x001E7, 0x00067}, {0x001E8, 0x0006B}, {0x001E9, 0x0006B}, {0x001EA, 0x0006F}, {0x001EB, 0x0006F}, {0x001EC, 0x0006F}, {0x001ED, 0x0006F},
+    {0x001EE, 0x00292}, {0x001EF, 0x00292}, {0x001F0, 0x0006A}, {0x001F1, 0x001F3}, {0x001F2, 0x001F3}, {0x001F4, 0x00067}, {0x001F5, 0x00067}, {0x001F6, 0x00195},
+    {0x001F7, 0x001BF}, {0x001F8, 0x0006E}, {0x001F9, 0x0006E}, {0x001FA, 0x00061}, {0x001FB, 0x00061}, {0x001FC, 0x000E6}, {0x001FD, 0x000E6}, {0x001FE, 0x000F8},
+    {0x001FF, 0x000F8}, {0x00200, 0x00061}, {0x00201, 0x00061}, {0x00202, 0x00061}, {0x00203, 0x00061}, {0x00204, 0x00065}, {0x00205, 0x00065}, {0x00206, 0x00065},
+    {0x00207, 0x00065}, {0x00208, 0x00069}, {0x00209, 0x00069}, {0x0020A, 0x00069}, {0x0020B, 0x00069}, {0x0020C, 0x0006F}, {0x0020D, 0x0006F}, {0x0020E, 0x0006F},
+    {0x0020F, 0x0006F}, {0x00210, 0x00072}, {0x00211, 0x00072}, {0x00212, 0x00072}, {0x00213, 0x00072}, {0x00214, 0x00075}, {0x00215, 0x00075}, {0x00216, 0x00075},
+    {0x00217, 0x00075}, {0x00218, 0x00073}, {0x00219, 0x00073}, {0x0021A, 0x00074}, {0x0021B, 0x00074}, {0x0021C, 0x0021D}, {0x0021E, 0x00068}, {0x0021F, 0x00068},
+    {0x00220, 0x0019E}, {0x00222, 0x00223}, {0x00224, 0x00225}, {0x00226, 0x00061}, {0x00227, 0x00061}, {0x00228, 0x00065}, {0x00229, 0x00065}, {0x0022A, 0x0006F},
+    {0x0022B, 0x0006F}, {0x0022C, 0x0006F}, {0x0022D, 0x0006F}, {0x0022E, 0x0006F}, {0x0022F, 0x0006F}, {0x00230, 0x0006F}, {0x00231, 0x0006F}, {0x00232, 0x00079},
+    {0x00233, 0x00079}, {0x0023A, 0x02C65}, {0x0023B, 0x0023C}, {0x0023D, 0x0019A}, {0x0023E, 0x02C66}, {0x00241, 0x00242}, {0x00243, 0x00180}, {0x00244, 0x00289},
+    {0x00245, 0x0028C}, {0x00246, 0x00247}, {0x00248, 0x00249}, {0x0024A, 0x0024B}, {0x0024C, 0x0024D}, {0x0024E, 0x0024F}, {0x00370, 0x00371}, {0x00372, 0x00373},
+    {0x00374, 0x002B9}, {0x00376, 0x00377}, {0x0037E, 0x0003B}, {0x0037F, 0x003F3}, {0x00385, 0x000A8}, {0x00386, 0x003B1}, {0x00387, 0x000B7}, {0x00388, 0x003B5},
+    {0x00389, 0x003B7}, {0x0038A, 0x003B9}, {0x0038C, 0x003BF}, {0x0038E, 0x003C5}, {0x0038F, 0x003C9}, {0x00390, 0x003B9}, {0x00391, 0x003B1}, {0x00392, 0x003B2},
+    {0x00393, 0x003B3}, {0x00394, 0x003B4}, {0x00395, 0x003B5}, {0x00396, 0x003B6}, {0x00397, 0x003B7}, {0x00398, 0x003B8}, {0x00399, 0x003B9}, {0x0039A, 0x003BA},
+    {0x0039B, 0x003BB}, {0x0039C, 0x003BC}, {0x0039D, 0x003BD}, {0x0039E, 0x003BE}, {0x0039F, 0x003BF}, {0x003A0, 0x003C0}, {0x003A1, 0x003C1}, {0x003A3, 0x003C3},
+    {0x003A4, 0x003C4}, {0x003A5, 0x003C5}, {0x003A6, 0x003C6}, {0x003A7, 0x003C7}, {0x003A8, 0x003C8}, {0x003A9, 0x003C9}, {0x003AA, 0x003B9}, {0x003AB, 0x003C5},
+    {0x003AC, 0x003B1}, {0x003AD, 0x003B5}, {0x003AE, 0x003B7}, {0x003AF, 0x003B9}, {0x003B0, 0x003C5}, {0x003CA, 0x003B9}, {0x003CB, 0x003C5}, {0x003CC, 0x003BF},
+    {0x003CD, 0x003C5}, {0x003CE, 0x003C9}, {0x003CF, 0x003D7}, {0x003D3, 0x003D2}, {0x003D4, 0x003D2}, {0x003D8, 0x003D9}, {0x003DA, 0x003DB}, {0x003DC, 0x003DD},
+    {0x003DE, 0x003DF}, {0x003E0, 0x003E1}, {0x003E2, 0x003E3}, {0x003E4, 0x003E5}, {0x003E6, 0x003E7}, {0x003E8, 0x003E9}, {0x003EA, 0x003EB}, {0x003EC, 0x003ED},
+    {0x003EE, 0x003EF}, {0x003F4, 0x003B8}, {0x003F7, 0x003F8}, {0x003F9, 0x003F2}, {0x003FA, 0x003FB}, {0x003FD, 0x0037B}, {0x003FE, 0x0037C}, {0x003FF, 0x0037D},
+    {0x00400, 0x00435}, {0x00401, 0x00435}, {0x00402, 0x00452}, {0x00403, 0x00433}, {0x00404, 0x00454}, {0x00405, 0x00455}, {0x00406, 0x00456}, {0x00407, 0x00456},
+    {0x00408, 0x00458}, {0x00409, 0x00459}, {0x0040A, 0x0045A}, {0x0040B, 0x0045B}, {0x0040C, 0x0043A}, {0x0040D, 0x00438}, {0x0040E, 0x00443}, {0x0040F, 0x0045F},
+    {0x00410, 0x00430}, {0x00411, 0x00431}, {0x00412, 0x00432}, {0x00413, 0x00433}, {0x00414, 0x00434}, {0x00415, 0x00435}, {0x00416, 0x00436}, {0x00417, 0x00437},
+    {0x00418, 0x00438}, {0x00419, 0x00438}, {0x0041A, 0x0043A}, {0x0041B, 0x0043B}, {0x0041C, 0x0043C}, {0x0041D, 0x0043D}, {0x0041E, 0x0043E}, {0x0041F, 0x0043F},
+    {0x00420, 0x00440}, {0x00421, 0x00441}, {0x00422, 0x00442}, {0x00423, 0x00443}, {0x00424, 0x00444}, {0x00425, 0x00445}, {0x00426, 0x00446}, {0x00427, 0x00447},
+    {0x00428, 0x00448}, {0x00429, 0x00449}, {0x0042A, 0x0044A}, {0x0042B, 0x0044B}, {0x0042C, 0x0044C}, {0x0042D, 0x0044D}, {0x0042E, 0x0044E}, {0x0042F, 0x0044F},
+    {0x00439, 0x00438}, {0x00450, 0x00435}, {0x00451, 0x00435}, {0x00453, 0x00433}, {0x00457, 0x00456}, {0x0045C, 0x0043A}, {0x0045D, 0x00438}, {0x0045E, 0x00443},
+    {0x00460, 0x00461}, {0x00462, 0x00463}, {0x00464, 0x00465}, {0x00466, 0x00467}, {0x00468, 0x00469}, {0x0046A, 0x0046B}, {0x0046C, 0x0046D}, {0x0046E, 0x0046F},
+    {0x00470, 0x00471}, {0x00472, 0x00473}, {0x00474, 0x00475}, {0x00476, 0x00475}, {0x00477, 0x00475}, {0x00478, 0x00479}, {0x0047A, 0x0047B}, {0x0047C, 0x0047D},
+    {0x0047E, 0x0047F}, {0x00480, 0x00481}, {0x0048A, 0x0048B}, {0x0048C, 0x0048D}, {0x0048E, 0x0048F}, {0x00490, 0x00491}, {0x00492, 0x00493}, {0x00494, 0x00495},
+    {0x00496, 0x00497}, {0x00498, 0x00499}, {0x0049A, 0x0049B}, {0x0049C, 0x0049D}, {0x0049E, 0x0049F}, {0x004A0, 0x004A1}, {0x004A2, 0x004A3}, {0x004A4, 0x004A5},
+    {0x004A6, 0x004A7}, {0x004A8, 0x004A9}, {0x004AA, 0x004AB}, {0x004AC, 0x004AD}, {0x004AE, 0x004AF}, {0x004B0, 0x004B1}, {0x004B2, 0x004B3}, {0x004B4, 0x004B5},
+    {0x004B6, 0x004B7}, {0x004B8, 0x004B9}, {0x004BA, 0x004BB}, {0x004BC, 0x004BD}, {0x004BE, 0x004BF}, {0x004C0, 0x004CF}, {0x004C1, 0x00436}, {0x004C2, 0x00436},
+    {0x004C3, 0x004C4}, {0x004C5, 0x004C6}, {0x004C7, 0x004C8}, {0x004C9, 0x004CA}, {0x004CB, 0x004CC}, {0x004CD, 0x004CE}, {0x004D0, 0x00430}, {0x004D1, 0x00430},
+    {0x004D2, 0x00430}, {0x004D3, 0x00430}, {0x004D4, 0x004D5}, {0x004D6, 0x00435}, {0x004D7, 0x00435}, {0x004D8, 0x004D9}, {0x004DA, 0x004D9}, {0x004DB, 0x004D9},
+    {0x004DC, 0x00436}, {0x004DD, 0x00436}, {0x004DE, 0x00437}, {0x004DF, 0x00437}, {0x004E0, 0x004E1}, {0x004E2, 0x00438}, {0x004E3, 0x00438}, {0x004E4, 0x00438},
+    {0x004E5, 0x00438}, {0x004E6, 0x0043E}, {0x004E7, 0x0043E}, {0x004E8, 0x004E9}, {0x004EA, 0x004E9}, {0x004EB, 0x004E9}, {0x004EC, 0x0044D}, {0x004ED, 0x0044D},
+    {0x004EE, 0x00443}, {0x004EF, 0x00443}, {0x004F0, 0x00443}, {0x004F1, 0x00443}, {0x004F2, 0x00443}, {0x004F3, 0x00443}, {0x004F4, 0x00447}, {0x004F5, 0x00447},
+    {0x004F6, 0x004F7}, {0x004F8, 0x0044B}, {0x004F9, 0x0044B}, {0x004FA, 0x004FB}, {0x004FC, 0x004FD}, {0x004FE, 0x004FF}, {0x00500, 0x00501}, {0x00502, 0x00503},
+    {0x00504, 0x00505}, {0x00506, 0x00507}, {0x00508, 0x00509}, {0x0050A, 0x0050B}, {0x0050C, 0x0050D}, {0x0050E, 0x0050F}, {0x00510, 0x00511}, {0x00512, 0x00513},
+    {0x00514, 0x00515}, {0x00516, 0x00517}, {0x00518, 0x00519}, {0x0051A, 0x0051B}, {0x0051C, 0x0051D}, {0x0051E, 0x0051F}, {0x00520, 0x00521}, {0x00522, 0x00523},
+    {0x00524, 0x00525}, {0x00526, 0x00527}, {0x00528, 0x00529}, {0x0052A, 0x0052B}, {0x0052C, 0x0052D}, {0x0052E, 0x0052F}, {0x00531, 0x00561}, {0x00532, 0x00562},
+    {0x00533, 0x00563}, {0x00534, 0x00564}, {0x00535, 0x00565}, {0x00536, 0x00566}, {0x00537, 0x00567}, {0x00538, 0x00568}, {0x00539, 0x00569}, {0x0053A, 0x0056A},
+    {0x0053B, 0x0056B}, {0x0053C, 0x0056C}, {0x0053D, 0x0056D}, {0x0053E, 0x0056E}, {0x0053F, 0x0056F}, {0x00540, 0x00570}, {0x00541, 0x00571}, {0x00542, 0x00572},
+    {0x00543, 0x00573}, {0x00544, 0x00574}, {0x00545, 0x00575}, {0x00546, 0x00576}, {0x00547, 0x00577}, {0x00548, 0x00578}, {0x00549, 0x00579}, {0x0054A, 0x0057A},
+    {0x0054B, 0x0057B}, {0x0054C, 0x0057C}, {0x0054D, 0x0057D}, {0x0054E, 0x0057E}, {0x0054F, 0x0057F}, {0x00550, 0x00580}, {0x00551, 0x00581}, {0x00552, 0x00582},
+    {0x00553, 0x00583}, {0x00554, 0x00584}, {0x00555, 0x00585}, {0x00556, 0x00586}, {0x00622, 0x00627}, {0x00623, 0x00627}, {0x00624, 0x00648}, {0x00625, 0x00627},
+    {0x00626, 0x0064A}, {0x006C0, 0x006D5}, {0x006C2, 0x006C1}, {0x006D3, 0x006D2}, {0x00929, 0x00928}, {0x00931, 0x00930}, {0x00934, 0x00933}, {0x00958, 0x00915},
+    {0x00959, 0x00916}, {0x0095A, 0x00917}, {0x0095B, 0x0091C}, {0x0095C, 0x00921}, {0x0095D, 0x00922}, {0x0095E, 0x0092B}, {0x0095F, 0x0092F}, {0x009DC, 0x009A1},
+    {0x009DD, 0x009A2}, {0x009DF, 0x009AF}, {0x00A33, 0x00A32}, {0x00A36, 0x00A38}, {0x00A59, 0x00A16}, {0x00A5A, 0x00A17}, {0x00A5B, 0x00A1C}, {0x00A5E, 0x00A2B},
+    {0x00B48, 0x00B47}, {0x00B5C, 0x00B21}, {0x00B5D, 0x00B22}, {0x00CC0, 0x00CD5}, {0x00CC7, 0x00CD5}, {0x00CC8, 0x00CD6}, {0x00CCA, 0x00CC2}, {0x00DDA, 0x00DD9},
+    {0x00F43, 0x00F42}, {0x00F4D, 0x00F4C}, {0x00F52, 0x00F51}, {0x00F57, 0x00F56}, {0x00F5C, 0x00F5B}, {0x00F69, 0x00F40}, {0x01026, 0x01025}, {0x010A0, 0x02D00},
+    {0x010A1, 0x02D01}, {0x010A2, 0x02D02}, {0x010A3, 0x02D03}, {0x010A4, 0x02D04}, {0x010A5, 0x02D05}, {0x010A6, 0x02D06}, {0x010A7, 0x02D07}, {0x010A8, 0x02D08},
+    {0x010A9, 0x02D09}, {0x010AA, 0x02D0A}, {0x010AB, 0x02D0B}, {0x010AC, 0x02D0C}, {0x010AD, 0x02D0D}, {0x010AE, 0x02D0E}, {0x010AF, 0x02D0F}, {0x010B0, 0x02D10},
+    {0x010B1, 0x02D11}, {0x010B2, 0x02D12}, {0x010B3, 0x02D13}, {0x010B4, 0x02D14}, {0x010B5, 0x02D15}, {0x010B6, 0x02D16}, {0x010B7, 0x02D17}, {0x010B8, 0x02D18},
+    {0x010B9, 0x02D19}, {0x010BA, 0x02D1A}, {0x010BB, 0x02D1B}, {0x010BC, 0x02D1C}, {0x010BD, 0x02D1D}, {0x010BE, 0x02D1E}, {0x010BF, 0x02D1F}, {0x010C0, 0x02D20},
+    {0x010C1, 0x02D21}, {0x010C2, 0x02D22}, {0x010C3, 0x02D23}, {0x010C4, 0x02D24}, {0x010C5, 0x02D25}, {0x010C7, 0x02D27}, {0x010CD, 0x02D2D}, {0x013A0, 0x0AB70},
+    {0x013A1, 0x0AB71}, {0x013A2, 0x0AB72}, {0x013A3, 0x0AB73}, {0x013A4, 0x0AB74}, {0x013A5, 0x0AB75}, {0x013A6, 0x0AB76}, {0x013A7, 0x0AB77}, {0x013A8, 0x0AB78},
+    {0x013A9, 0x0AB79}, {0x013AA, 0x0AB7A}, {0x013AB, 0x0AB7B}, {0x013AC, 0x0AB7C}, {0x013AD, 0x0AB7D}, {0x013AE, 0x0AB7E}, {0x013AF, 0x0AB7F}, {0x013B0, 0x0AB80},
+    {0x013B1, 0x0AB81}, {0x013B2, 0x0AB82}, {0x013B3, 0x0AB83}, {0x013B4, 0x0AB84}, {0x013B5, 0x0AB85}, {0x013B6, 0x0AB86}, {0x013B7, 0x0AB87}, {0x013B8, 0x0AB88},
+    {0x013B9, 0x0AB89}, {0x013BA, 0x0AB8A}, {0x013BB, 0x0AB8B}, {0x013BC, 0x0AB8C}, {0x013BD, 0x0AB8D}, {0x013BE, 0x0AB8E}, {0x013BF, 0x0AB8F}, {0x013C0, 0x0AB90},
+    {0x013C1, 0x0AB91}, {0x013C2, 0x0AB92}, {0x013C3, 0x0AB93}, {0x013C4, 0x0AB94}, {0x013C5, 0x0AB95}, {0x013C6, 0x0AB96}, {0x013C7, 0x0AB97}, {0x013C8, 0x0AB98},
+    {0x013C9, 0x0AB99}, {0x013CA, 0x0AB9A}, {0x013CB, 0x0AB9B}, {0x013CC, 0x0AB9C}, {0x013CD, 0x0AB9D}, {0x013CE, 0x0AB9E}, {0x013CF, 0x0AB9F}, {0x013D0, 0x0ABA0},
+    {0x013D1, 0x0ABA1}, {0x013D2, 0x0ABA2}, {0x013D3, 0x0ABA3}, {0x013D4, 0x0ABA4}, {0x013D5, 0x0ABA5}, {0x013D6, 0x0ABA6}, {0x013D7, 0x0ABA7}, {0x013D8, 0x0ABA8},
+    {0x013D9, 0x0ABA9}, {0x013DA, 0x0ABAA}, {0x013DB, 0x0ABAB}, {0x013DC, 0x0ABAC}, {0x013DD, 0x0ABAD}, {0x013DE, 0x0ABAE}, {0x013DF, 0x0ABAF}, {0x013E0, 0x0ABB0},
+    {0x013E1, 0x0ABB1}, {0x013E2, 0x0ABB2}, {0x013E3, 0x0ABB3}, {0x013E4, 0x0ABB4}, {0x013E5, 0x0ABB5}, {0x013E6, 0x0ABB6}, {0x013E7, 0x0ABB7}, {0x013E8, 0x0ABB8},
+    {0x013E9, 0x0ABB9}, {0x013EA, 0x0ABBA}, {0x013EB, 0x0ABBB}, {0x013EC, 0x0ABBC}, {0x013ED, 0x0ABBD}, {0x013EE, 0x0ABBE}, {0x013EF, 0x0ABBF}, {0x013F0, 0x013F8},
+    {0x013F1, 0x013F9}, {0x013F2, 0x013FA}, {0x013F3, 0x013FB}, {0x013F4, 0x013FC}, {0x013F5, 0x013FD}, {0x01B3B, 0x01B35}, {0x01B3D, 0x01B35}, {0x01B43, 0x01B35},
+    {0x01C90, 0x010D0}, {0x01C91, 0x010D1}, {0x01C92, 0x010D2}, {0x01C93, 0x010D3}, {0x01C94, 0x010D4}, {0x01C95, 0x010D5}, {0x01C96, 0x010D6}, {0x01C97, 0x010D7},
+    {0x01C98, 0x010D8}, {0x01C99, 0x010D9}, {0x01C9A, 0x010DA}, {0x01C9B, 0x010DB}, {0x01C9C, 0x010DC}, {0x01C9D, 0x010DD}, {0x01C9E, 0x010DE}, {0x01C9F, 0x010DF},
+    {0x01CA0, 0x010E0}, {0x01CA1, 0x010E1}, {0x01CA2, 0x010E2}, {0x01CA3, 0x010E3}, {0x01CA4, 0x010E4}, {0x01CA5, 0x010E5}, {0x01CA6, 0x010E6}, {0x01CA7, 0x010E7},
+    {0x01CA8, 0x010E8}, {0x01CA9, 0x010E9}, {0x01CAA, 0x010EA}, {0x01CAB, 0x010EB}, {0x01CAC, 0x010EC}, {0x01CAD, 0x010ED}, {0x01CAE, 0x010EE}, {0x01CAF, 0x010EF},
+    {0x01CB0, 0x010F0}, {0x01CB1, 0x010F1}, {0x01CB2, 0x010F2}, {0x01CB3, 0x010F3}, {0x01CB4, 0x010F4}, {0x01CB5, 0x010F5}, {0x01CB6, 0x010F6}, {0x01CB7, 0x010F7},
+    {0x01CB8, 0x010F8}, {0x01CB9, 0x010F9}, {0x01CBA, 0x010FA}, {0x01CBD, 0x010FD}, {0x01CBE, 0x010FE}, {0x01CBF, 0x010FF}, {0x01E00, 0x00061}, {0x01E01, 0x00061},
+    {0x01E02, 0x00062}, {0x01E03, 0x00062}, {0x01E04, 0x00062}, {0x01E05, 0x00062}, {0x01E06, 0x00062}, {0x01E07, 0x00062}, {0x01E08, 0x00063}, {0x01E09, 0x00063},
+    {0x01E0A, 0x00064}, {0x01E0B, 0x00064}, {0x01E0C, 0x00064}, {0x01E0D, 0x00064}, {0x01E0E, 0x00064}, {0x01E0F, 0x00064}, {0x01E10, 0x00064}, {0x01E11, 0x00064},
+    {0x01E12, 0x00064}, {0x01E13, 0x00064}, {0x01E14, 0x00065}, {0x01E15, 0x00065}, {0x01E16, 0x00065}, {0x01E17, 0x00065}, {0x01E18, 0x00065}, {0x01E19, 0x00065},
+    {0x01E1A, 0x00065}, {0x01E1B, 0x00065}, {0x01E1C, 0x00065}, {0x01E1D, 0x00065}, {0x01E1E, 0x00066}, {0x01E1F, 0x00066}, {0x01E20, 0x00067}, {0x01E21, 0x00067},
+    {0x01E22, 0x00068}, {0x01E23, 0x00068}, {0x01E24, 0x00068}, {0x01E25, 0x00068}, {0x01E26, 0x00068}, {0x01E27, 0x00068}, {0x01E28, 0x00068}, {0x01E29, 0x00068},
+    {0x01E2A, 0x00068}, {0x01E2B, 0x00068}, {0x01E2C, 0x00069}, {0x01E2D, 0x00069}, {0x01E2E, 0x00069}, {0x01E2F, 0x00069}, {0x01E30, 0x0006B}, {0x01E31, 0x0006B},
+    {0x01E32, 0x0006B}, {0x01E33, 0x0006B}, {0x01E34, 0x0006B}, {0x01E35, 0x0006B}, {0x01E36, 0x0006C}, {0x01E37, 0x0006C}, {0x01E38, 0x0006C}, {0x01E39, 0x0006C},
+    {0x01E3A, 0x0006C}, {0x01E3B, 0x0006C}, {0x01E3C, 0x0006C}, {0x01E3D, 0x0006C}, {0x01E3E, 0x0006D}, {0x01E3F, 0x0006D}, {0x01E40, 0x0006D}, {0x01E41, 0x0006D},
+    {0x01E42, 0x0006D}, {0x01E43, 0x0006D}, {0x01E44, 0x0006E}, {0x01E45, 0x0006E}, {0x01E46, 0x0006E}, {0x01E47, 0x0006E}, {0x01E48, 0x0006E}, {0x01E49, 0x0006E},
+    {0x01E4A, 0x0006E}, {0x01E4B, 0x0006E}, {0x01E4C, 0x0006F}, {0x01E4D, 0x0006F}, {0x01E4E, 0x0006F}, {0x01E4F, 0x0006F}, {0x01E50, 0x0006F}, {0x01E51, 0x0006F},
+    {0x01E52, 0x0006F}, {0x01E53, 0x0006F}, {0x01E54, 0x00070}, {0x01E55, 0x00070}, {0x01E56, 0x00070}, {0x01E57, 0x00070}, {0x01E58, 0x00072}, {0x01E59, 0x00072},
+    {0x01E5A, 0x00072}, {0x01E5B, 0x00072}, {0x01E5C, 0x00072}, {0x01E5D, 0x00072}, {0x01E5E, 0x00072}, {0x01E5F, 0x00072}, {0x01E60, 0x00073}, {0x01E61, 0x00073},
+    {0x01E62, 0x00073}, {0x01E63, 0x00073}, {0x01E64, 0x00073}, {0x01E65, 0x00073}, {0x01E66, 0x00073}, {0x01E67, 0x00073}, {0x01E68, 0x00073}, {0x01E69, 0x00073},
+    {0x01E6A, 0x00074}, {0x01E6B, 0x00074}, {0x01E6C, 0x00074}, {0x01E6D, 0x00074}, {0x01E6E, 0x00074}, {0x01E6F, 0x00074}, {0x01E70, 0x00074}, {0x01E71, 0x00074},
+    {0x01E72, 0x00075}, {0x01E73, 0x00075}, {0x01E74, 0x00075}, {0x01E75, 0x00075}, {0x01E76, 0x00075}, {0x01E77, 0x00075}, {0x01E78, 0x00075}, {0x01E79, 0x00075},
+    {0x01E7A, 0x00075}, {0x01E7B, 0x00075}, {0x01E7C, 0x00076}, {0x01E7D, 0x00076}, {0x01E7E, 0x00076}, {0x01E7F, 0x00076}, {0x01E80, 0x00077}, {0x01E81, 0x00077},
+    {0x01E82, 0x00077}, {0x01E83, 0x00077}, {0x01E84, 0x00077}, {0x01E85, 0x00077}, {0x01E86, 0x00077}, {0x01E87, 0x00077}, {0x01E88, 0x00077}, {0x01E89, 0x00077},
+    {0x01E8A, 0x00078}, {0x01E8B, 0x00078}, {0x01E8C, 0x00078}, {0x01E8D, 0x00078}, {0x01E8E, 0x00079}, {0x01E8F, 0x00079}, {0x01E90, 0x0007A}, {0x01E91, 0x0007A},
+    {0x01E92, 0x0007A}, {0x01E93, 0x0007A}, {0x01E94, 0x0007A}, {0x01E95, 0x0007A}, {0x01E96, 0x00068}, {0x01E97, 0x00074}, {0x01E98, 0x00077}, {0x01E99, 0x00079},
+    {0x01E9B, 0x0017F}, {0x01E9E, 0x000DF}, {0x01EA0, 0x00061}, {0x01EA1, 0x00061}, {0x01EA2, 0x00061}, {0x01EA3, 0x00061}, {0x01EA4, 0x00061}, {0x01EA5, 0x00061},
+    {0x01EA6, 0x00061}, {0x01EA7, 0x00061}, {0x01EA8, 0x00061}, {0x01EA9, 0x00061}, {0x01EAA, 0x00061}, {0x01EAB, 0x00061}, {0x01EAC, 0x00061}, {0x01EAD, 0x00061},
+    {0x01EAE, 0x00061}, {0x01EAF, 0x00061}, {0x01EB0, 0x00061}, {0x01EB1, 0x00061}, {0x01EB2, 0x00061}, {0x01EB3, 0x00061}, {0x01EB4, 0x00061}, {0x01EB5, 0x00061},
+    {0x01EB6, 0x00061}, {0x01EB7, 0x00061}, {0x01EB8, 0x00065}, {0x01EB9, 0x00065}, {0x01EBA, 0x00065}, {0x01EBB, 0x00065}, {0x01EBC, 0x00065}, {0x01EBD, 0x00065},
+    {0x01EBE, 0x00065}, {0x01EBF, 0x00065}, {0x01EC0, 0x00065}, {0x01EC1, 0x00065}, {0x01EC2, 0x00065}, {0x01EC3, 0x00065}, {0x01EC4, 0x00065}, {0x01EC5, 0x00065},
+    {0x01EC6, 0x00065}, {0x01EC7, 0x00065}, {0x01EC8, 0x00069}, {0x01EC9, 0x00069}, {0x01ECA, 0x00069}, {0x01ECB, 0x00069}, {0x01ECC, 0x0006F}, {0x01ECD, 0x0006F},
+    {0x01ECE, 0x0006F}, {0x01ECF, 0x0006F}, {0x01ED0, 0x0006F}, {0x01ED1, 0x0006F}, {0x01ED2, 0x0006F}, {0x01ED3, 0x0006F}, {0x01ED4, 0x0006F}, {0x01ED5, 0x0006F},
+    {0x01ED6, 0x0006F}, {0x01ED7, 0x0006F}, {0x01ED8, 0x0006F}, {0x01ED9, 0x0006F}, {0x01EDA, 0x0006F}, {0x01EDB, 0x0006F}, {0x01EDC, 0x0006F}, {0x01EDD, 0x0006F},
+    {0x01EDE, 0x0006F}, {0x01EDF, 0x0006F}, {0x01EE0, 0x0006F}, {0x01EE1, 0x0006F}, {0x01EE2, 0x0006F}, {0x01EE3, 0x0006F}, {0x01EE4, 0x00075}, {0x01EE5, 0x00075},
+    {0x01EE6, 0x00075}, {0x01EE7, 0x00075}, {0x01EE8, 0x00075}, {0x01EE9, 0x00075}, {0x01EEA, 0x00075}, {0x01EEB, 0x00075}, {0x01EEC, 0x00075}, {0x01EED, 0x00075},
+    {0x01EEE, 0x00075}, {0x01EEF, 0x00075}, {0x01EF0, 0x00075}, {0x01EF1, 0x00075}, {0x01EF2, 0x00079}, {0x01EF3, 0x00079}, {0x01EF4, 0x00079}, {0x01EF5, 0x00079},
+    {0x01EF6, 0x00079}, {0x01EF7, 0x00079}, {0x01EF8, 0x00079}, {0x01EF9, 0x00079}, {0x01EFA, 0x01EFB}, {0x01EFC, 0x01EFD}, {0x01EFE, 0x01EFF}, {0x01F00, 0x003B1},
+    {0x01F01, 0x003B1}, {0x01F02, 0x003B1}, {0x01F03, 0x003B1}, {0x01F04, 0x003B1}, {0x01F05, 0x003B1}, {0x01F06, 0x003B1}, {0x01F07, 0x003B1}, {0x01F08, 0x003B1},
+    {0x01F09, 0x003B1}, {0x01F0A, 0x003B1}, {0x01F0B, 0x003B1}, {0x01F0C, 0x003B1}, {0x01F0D, 0x003B1}, {0x01F0E, 0x003B1}, {0x01F0F, 0x003B1}, {0x01F10, 0x003B5},
+    {0x01F11, 0x003B5}, {0x01F12, 0x003B5}, {0x01F13, 0x003B5}, {0x01F14, 0x003B5}, {0x01F15, 0x003B5}, {0x01F18, 0x003B5}, {0x01F19, 0x003B5}, {0x01F1A, 0x003B5},
+    {0x01F1B, 0x003B5}, {0x01F1C, 0x003B5}, {0x01F1D, 0x003B5}, {0x01F20, 0x003B7}, {0x01F21, 0x003B7}, {0x01F22, 0x003B7}, {0x01F23, 0x003B7}, {0x01F24, 0x003B7},
+    {0x01F25, 0x003B7}, {0x01F26, 0x003B7}, {0x01F27, 0x003B7}, {0x01F28, 0x003B7}, {0x01F29, 0x003B7}, {0x01F2A, 0x003B7}, {0x01F2B, 0x003B7}, {0x01F2C, 0x003B7},
+    {0x01F2D, 0x003B7}, {0x01F2E, 0x003B7}, {0x01F2F, 0x003B7}, {0x01F30, 0x003B9}, {0x01F31, 0x003B9}, {0x01F32, 0x003B9}, {0x01F33, 0x003B9}, {0x01F34, 0x003B9},
+    {0x01F35, 0x003B9}, {0x01F36, 0x003B9}, {0x01F37, 0x003B9}, {0x01F38, 0x003B9}, {0x01F39, 0x003B9}, {0x01F3A, 0x003B9}, {0x01F3B, 0x003B9}, {0x01F3C, 0x003B9},
+    {0x01F3D, 0x003B9}, {0x01F3E, 0x003B9}, {0x01F3F, 0x003B9}, {0x01F40, 0x003BF}, {0x01F41, 0x003BF}, {0x01F42, 0x003BF}, {0x01F43, 0x003BF}, {0x01F44, 0x003BF},
+    {0x01F45, 0x003BF}, {0x01F48, 0x003BF}, {0x01F49, 0x003BF}, {0x01F4A, 0x003BF}, {0x01F4B, 0x003BF}, {0x01F4C, 0x003BF}, {0x01F4D, 0x003BF}, {0x01F50, 0x003C5},
+    {0x01F51, 0x003C5}, {0x01F52, 0x003C5}, {0x01F53, 0x003C5}, {0x01F54, 0x003C5}, {0x01F55, 0x003C5}, {0x01F56, 0x003C5}, {0x01F57, 0x003C5}, {0x01F59, 0x003C5},
+    {0x01F5B, 0x003C5}, {0x01F5D, 0x003C5}, {0x01F5F, 0x003C5}, {0x01F60, 0x003C9}, {0x01F61, 0x003C9}, {0x01F62, 0x003C9}, {0x01F63, 0x003C9}, {0x01F64, 0x003C9},
+    {0x01F65, 0x003C9}, {0x01F66, 0x003C9}, {0x01F67, 0x003C9}, {0x01F68, 0x003C9}, {0x01F69, 0x003C9}, {0x01F6A, 0x003C9}, {0x01F6B, 0x003C9}, {0x01F6C, 0x003C9},
+    {0x01F6D, 0x003C9}, {0x01F6E, 0x003C9}, {0x01F6F, 0x003C9}, {0x01F70, 0x003B1}, {0x01F71, 0x003B1}, {0x01F72, 0x003B5}, {0x01F73, 0x003B5}, {0x01F74, 0x003B7},
+    {0x01F75, 0x003B7}, {0x01F76, 0x003B9}, {0x01F77, 0x003B9}, {0x01F78, 0x003BF}, {0x01F79, 0x003BF}, {0x01F7A, 0x003C5}, {0x01F7B, 0x003C5}, {0x01F7C, 0x003C9},
+    {0x01F7D, 0x003C9}, {0x01F80, 0x003B1}, {0x01F81, 0x003B1}, {0x01F82, 0x003B1}, {0x01F83, 0x003B1}, {0x01F84, 0x003B1}, {0x01F85, 0x003B1}, {0x01F86, 0x003B1},
+    {0x01F87, 0x003B1}, {0x01F88, 0x003B1}, {0x01F89, 0x003B1}, {0x01F8A, 0x003B1}, {0x01F8B, 0x003B1}, {0x01F8C, 0x003B1}, {0x01F8D, 0x003B1}, {0x01F8E, 0x003B1},
+    {0x01F8F, 0x003B1}, {0x01F90, 0x003B7}, {0x01F91, 0x003B7}, {0x01F92, 0x003B7}, {0x01F93, 0x003B7}, {0x01F94, 0x003B7}, {0x01F95, 0x003B7}, {0x01F96, 0x003B7},
+    {0x01F97, 0x003B7}, {0x01F98, 0x003B7}, {0x01F99, 0x003B7}, {0x01F9A, 0x003B7}, {0x01F9B, 0x003B7}, {0x01F9C, 0x003B7}, {0x01F9D, 0x003B7}, {0x01F9E, 0x003B7},
+    {0x01F9F, 0x003B7}, {0x01FA0, 0x003C9}, {0x01FA1, 0x003C9}, {0x01FA2, 0x003C9}, {0x01FA3, 0x003C9}, {0x01FA4, 0x003C9}, {0x01FA5, 0x003C9}, {0x01FA6, 0x003C9},
+    {0x01FA7, 0x003C9}, {0x01FA8, 0x003C9}, {0x01FA9, 0x003C9}, {0x01FAA, 0x003C9}, {0x01FAB, 0x003C9}, {0x01FAC, 0x003C9}, {0x01FAD, 0x003C9}, {0x01FAE, 0x003C9},
+    {0x01FAF, 0x003C9}, {0x01FB0, 0x003B1}, {0x01FB1, 0x003B1}, {0x01FB2, 0x003B1}, {0x01FB3, 0x003B1}, {0x01FB4, 0x003B1}, {0x01FB6, 0x003B1}, {0x01FB7, 0x003B1},
+    {0x01FB8, 0x003B1}, {0x01FB9, 0x003B1}, {0x01FBA, 0x003B1}, {0x01FBB, 0x003B1}, {0x01FBC, 0x003B1}, {0x01FBE, 0x003B9}, {0x01FC1, 0x000A8}, {0x01FC2, 0x003B7},
+    {0x01FC3, 0x003B7}, {0x01FC4, 0x003B7}, {0x01FC6, 0x003B7}, {0x01FC7, 0x003B7}, {0x01FC8, 0x003B5}, {0x01FC9, 0x003B5}, {0x01FCA, 0x003B7}, {0x01FCB, 0x003B7},
+    {0x01FCC, 0x003B7}, {0x01FCD, 0x01FBF}, {0x01FCE, 0x01FBF}, {0x01FCF, 0x01FBF}, {0x01FD0, 0x003B9}, {0x01FD1, 0x003B9}, {0x01FD2, 0x003B9}, {0x01FD3, 0x003B9},
+    {0x01FD6, 0x003B9}, {0x01FD7, 0x003B9}, {0x01FD8, 0x003B9}, {0x01FD9, 0x003B9}, {0x01FDA, 0x003B9}, {0x01FDB, 0x003B9}, {0x01FDD, 0x01FFE}, {0x01FDE, 0x01FFE},
+    {0x01FDF, 0x01FFE}, {0x01FE0, 0x003C5}, {0x01FE1, 0x003C5}, {0x01FE2, 0x003C5}, {0x01FE3, 0x003C5}, {0x01FE4, 0x003C1}, {0x01FE5, 0x003C1}, {0x01FE6, 0x003C5},
+    {0x01FE7, 0x003C5}, {0x01FE8, 0x003C5}, {0x01FE9, 0x003C5}, {0x01FEA, 0x003C5}, {0x01FEB, 0x003C5}, {0x01FEC, 0x003C1}, {0x01FED, 0x000A8}, {0x01FEE, 0x000A8},
+    {0x01FEF, 0x00060}, {0x01FF2, 0x003C9}, {0x01FF3, 0x003C9}, {0x01FF4, 0x003C9}, {0x01FF6, 0x003C9}, {0x01FF7, 0x003C9}, {0x01FF8, 0x003BF}, {0x01FF9, 0x003BF},
+    {0x01FFA, 0x003C9}, {0x01FFB, 0x003C9}, {0x01FFC, 0x003C9}, {0x01FFD, 0x000B4}, {0x02000, 0x02002}, {0x02001, 0x02003}, {0x02126, 0x003C9}, {0x0212A, 0x0006B},
+    {0x0212B, 0x00061}, {0x02132, 0x0214E}, {0x02160, 0x02170}, {0x02161, 0x02171}, {0x02162, 0x02172}, {0x02163, 0x02173}, {0x02164, 0x02174}, {0x02165, 0x02175},
+    {0x02166, 0x02176}, {0x02167, 0x02177}, {0x02168, 0x02178}, {0x02169, 0x02179}, {0x0216A, 0x0217A}, {0x0216B, 0x0217B}, {0x0216C, 0x0217C}, {0x0216D, 0x0217D},
+    {0x0216E, 0x0217E}, {0x0216F, 0x0217F}, {0x02183, 0x02184}, {0x0219A, 0x02190}, {0x0219B, 0x02192}, {0x021AE, 0x02194}, {0x021CD, 0x021D0}, {0x021CE, 0x021D4},
+    {0x021CF, 0x021D2}, {0x02204, 0x02203}, {0x02209, 0x02208}, {0x0220C, 0x0220B}, {0x02224, 0x02223}, {0x02226, 0x02225}, {0x02241, 0x0223C}, {0x02244, 0x02243},
+    {0x02247, 0x02245}, {0x02249, 0x02248}, {0x02260, 0x0003D}, {0x02262, 0x02261}, {0x0226D, 0x0224D}, {0x0226E, 0x0003C}, {0x0226F, 0x0003E}, {0x02270, 0x02264},
+    {0x02271, 0x02265}, {0x02274, 0x02272}, {0x02275, 0x02273}, {0x02278, 0x02276}, {0x02279, 0x02277}, {0x02280, 0x0227A}, {0x02281, 0x0227B}, {0x02284, 0x02282},
+    {0x02285, 0x02283}, {0x02288, 0x02286}, {0x02289, 0x02287}, {0x022AC, 0x022A2}, {0x022AD, 0x022A8}, {0x022AE, 0x022A9}, {0x022AF, 0x022AB}, {0x022E0, 0x0227C},
+    {0x022E1, 0x0227D}, {0x022E2, 0x02291}, {0x022E3, 0x02292}, {0x022EA, 0x022B2}, {0x022EB, 0x022B3}, {0x022EC, 0x022B4}, {0x022ED, 0x022B5}, {0x02329, 0x03008},
+    {0x0232A, 0x03009}, {0x024B6, 0x024D0}, {0x024B7, 0x024D1}, {0x024B8, 0x024D2}, {0x024B9, 0x024D3}, {0x024BA, 0x024D4}, {0x024BB, 0x024D5}, {0x024BC, 0x024D6},
+    {0x024BD, 0x024D7}, {0x024BE, 0x024D8}, {0x024BF, 0x024D9}, {0x024C0, 0x024DA}, {0x024C1, 0x024DB}, {0x024C2, 0x024DC}, {0x024C3, 0x024DD}, {0x024C4, 0x024DE},
+    {0x024C5, 0x024DF}, {0x024C6, 0x024E0}, {0x024C7, 0x024E1}, {0x024C8, 0x024E2}, {0x024C9, 0x024E3}, {0x024CA, 0x024E4}, {0x024CB, 0x024E5}, {0x024CC, 0x024E6},
+    {0x024CD, 0x024E7}, {0x024CE, 0x024E8}, {0x024CF, 0x024E9}, {0x02ADC, 0x02ADD}, {0x02C00, 0x02C30}, {0x02C01, 0x02C31}, {0x02C02, 0x02C32}, {0x02C03, 0x02C33},
+    {0x02C04, 0x02C34}, {0x02C05, 0x02C35}, {0x02C06, 0x02C36}, {0x02C07, 0x02C37}, {0x02C08, 0x02C38}, {0x02C09, 0x02C39}, {0x02C0A, 0x02C3A}, {0x02C0B, 0x02C3B},
+    {0x02C0C, 0x02C3C}, {0x02C0D, 0x02C3D}, {0x02C0E, 0x02C3E}, {0x02C0F, 0x02C3F}, {0x02C10, 0x02C40}, {0x02C11, 0x02C41}, {0x02C12, 0x02C42}, {0x02C13, 0x02C43},
+    {0x02C14, 0x02C44}, {0x02C15, 0x02C45}, {0x02C16, 0x02C46}, {0x02C17, 0x02C47}, {0x02C18, 0x02C48}, {0x02C19, 0x02C49}, {0x02C1A, 0x02C4A}, {0x02C1B, 0x02C4B},
+    {0x02C1C, 0x02C4C}, {0x02C1D, 0x02C4D}, {0x02C1E, 0x02C4E}, {0x02C1F, 0x02C4F}, {0x02C20, 0x02C50}, {0x02C21, 0x02C51}, {0x02C22, 0x02C52}, {0x02C23, 0x02C53},
+    {0x02C24, 0x02C54}, {0x02C25, 0x02C55}, {0x02C26, 0x02C56}, {0x02C27, 0x02C57}, {0x02C28, 0x02C58}, {0x02C29, 0x02C59}, {0x02C2A, 0x02C5A}, {0x02C2B, 0x02C5B},
+    {0x02C2C, 0x02C5C}, {0x02C2D, 0x02C5D}, {0x02C2E, 0x02C5E}, {0x02C2F, 0x02C5F}, {0x02C60, 0x02C61}, {0x02C62, 0x0026B}, {0x02C63, 0x01D7D}, {0x02C64, 0x0027D},
+    {0x02C67, 0x02C68}, {0x02C69, 0x02C6A}, {0x02C6B, 0x02C6C}, {0x02C6D, 0x00251}, {0x02C6E, 0x00271}, {0x02C6F, 0x00250}, {0x02C70, 0x00252}, {0x02C72, 0x02C73},
+    {0x02C75, 0x02C76}, {0x02C7E, 0x0023F}, {0x02C7F, 0x00240}, {0x02C80, 0x02C81}, {0x02C82, 0x02C83}, {0x02C84, 0x02C85}, {0x02C86, 0x02C87}, {0x02C88, 0x02C89},
+    {0x02C8A, 0x02C8B}, {0x02C8C, 0x02C8D}, {0x02C8E, 0x02C8F}, {0x02C90, 0x02C91}, {0x02C92, 0x02C93}, {0x02C94, 0x02C95}, {0x02C96, 0x02C97}, {0x02C98, 0x02C99},
+    {0x02C9A, 0x02C9B}, {0x02C9C, 0x02C9D}, {0x02C9E, 0x02C9F}, {0x02CA0, 0x02CA1}, {0x02CA2, 0x02CA3}, {0x02CA4, 0x02CA5}, {0x02CA6, 0x02CA7}, {0x02CA8, 0x02CA9},
+    {0x02CAA, 0x02CAB}, {0x02CAC, 0x02CAD}, {0x02CAE, 0x02CAF}, {0x02CB0, 0x02CB1}, {0x02CB2, 0x02CB3}, {0x02CB4, 0x02CB5}, {0x02CB6, 0x02CB7}, {0x02CB8, 0x02CB9},
+    {0x02CBA, 0x02CBB}, {0x02CBC, 0x02CBD}, {0x02CBE, 0x02CBF}, {0x02CC0, 0x02CC1}, {0x02CC2, 0x02CC3}, {0x02CC4, 0x02CC5}, {0x02CC6, 0x02CC7}, {0x02CC8, 0x02CC9},
+    {0x02CCA, 0x02CCB}, {0x02CCC, 0x02CCD}, {0x02CCE, 0x02CCF}, {0x02CD0, 0x02CD1}, {0x02CD2, 0x02CD3}, {0x02CD4, 0x02CD5}, {0x02CD6, 0x02CD7}, {0x02CD8, 0x02CD9},
+    {0x02CDA, 0x02CDB}, {0x02CDC, 0x02CDD}, {0x02CDE, 0x02CDF}, {0x02CE0, 0x02CE1}, {0x02CE2, 0x02CE3}, {0x02CEB, 0x02CEC}, {0x02CED, 0x02CEE}, {0x02CF2, 0x02CF3},
+    {0x0304C, 0x0304B}, {0x0304E, 0x0304D}, {0x03050, 0x0304F}, {0x03052, 0x03051}, {0x03054, 0x03053}, {0x03056, 0x03055}, {0x03058, 0x03057}, {0x0305A, 0x03059},
+    {0x0305C, 0x0305B}, {0x0305E, 0x0305D}, {0x03060, 0x0305F}, {0x03062, 0x03061}, {0x03065, 0x03064}, {0x03067, 0x03066}, {0x03069, 0x03068}, {0x03070, 0x0306F},
+    {0x03071, 0x0306F}, {0x03073, 0x03072}, {0x03074, 0x03072}, {0x03076, 0x03075}, {0x03077, 0x03075}, {0x03079, 0x03078}, {0x0307A, 0x03078}, {0x0307C, 0x0307B},
+    {0x0307D, 0x0307B}, {0x03094, 0x03046}, {0x0309E, 0x0309D}, {0x030AC, 0x030AB}, {0x030AE, 0x030AD}, {0x030B0, 0x030AF}, {0x030B2, 0x030B1}, {0x030B4, 0x030B3},
+    {0x030B6, 0x030B5}, {0x030B8, 0x030B7}, {0x030BA, 0x030B9}, {0x030BC, 0x030BB}, {0x030BE, 0x030BD}, {0x030C0, 0x030BF}, {0x030C2, 0x030C1}, {0x030C5, 0x030C4},
+    {0x030C7, 0x030C6}, {0x030C9, 0x030C8}, {0x030D0, 0x030CF}, {0x030D1, 0x030CF}, {0x030D3, 0x030D2}, {0x030D4, 0x030D2}, {0x030D6, 0x030D5}, {0x030D7, 0x030D5},
+    {0x030D9, 0x030D8}, {0x030DA, 0x030D8}, {0x030DC, 0x030DB}, {0x030DD, 0x030DB}, {0x030F4, 0x030A6}, {0x030F7, 0x030EF}, {0x030F8, 0x030F0}, {0x030F9, 0x030F1},
+    {0x030FA, 0x030F2}, {0x030FE, 0x030FD}, {0x0A640, 0x0A641}, {0x0A642, 0x0A643}, {0x0A644, 0x0A645}, {0x0A646, 0x0A647}, {0x0A648, 0x0A649}, {0x0A64A, 0x0A64B},
+    {0x0A64C, 0x0A64D}, {0x0A64E, 0x0A64F}, {0x0A650, 0x0A651}, {0x0A652, 0x0A653}, {0x0A654, 0x0A655}, {0x0A656, 0x0A657}, {0x0A658, 0x0A659}, {0x0A65A, 0x0A65B},
+    {0x0A65C, 0x0A65D}, {0x0A65E, 0x0A65F}, {0x0A660, 0x0A661}, {0x0A662, 0x0A663}, {0x0A664, 0x0A665}, {0x0A666, 0x0A667}, {0x0A668, 0x0A669}, {0x0A66A, 0x0A66B},
+    {0x0A66C, 0x0A66D}, {0x0A680, 0x0A681}, {0x0A682, 0x0A683}, {0x0A684, 0x0A685}, {0x0A686, 0x0A687}, {0x0A688, 0x0A689}, {0x0A68A, 0x0A68B}, {0x0A68C, 0x0A68D},
+    {0x0A68E, 0x0A68F}, {0x0A690, 0x0A691}, {0x0A692, 0x0A693}, {0x0A694, 0x0A695}, {0x0A696, 0x0A697}, {0x0A698, 0x0A699}, {0x0A69A, 0x0A69B}, {0x0A722, 0x0A723},
+    {0x0A724, 0x0A725}, {0x0A726, 0x0A727}, {0x0A728, 0x0A729}, {0x0A72A, 0x0A72B}, {0x0A72C, 0x0A72D}, {0x0A72E, 0x0A72F}, {0x0A732, 0x0A733}, {0x0A734, 0x0A735},
+    {0x0A736, 0x0A737}, {0x0A738, 0x0A739}, {0x0A73A, 0x0A73B}, {0x0A73C, 0x0A73D}, {0x0A73E, 0x0A73F}, {0x0A740, 0x0A741}, {0x0A742, 0x0A743}, {0x0A744, 0x0A745},
+    {0x0A746, 0x0A747}, {0x0A748, 0x0A749}, {0x0A74A, 0x0A74B}, {0x0A74C, 0x0A74D}, {0x0A74E, 0x0A74F}, {0x0A750, 0x0A751}, {0x0A752, 0x0A753}, {0x0A754, 0x0A755},
+    {0x0A756, 0x0A757}, {0x0A758, 0x0A759}, {0x0A75A, 0x0A75B}, {0x0A75C, 0x0A75D}, {0x0A75E, 0x0A75F}, {0x0A760, 0x0A761}, {0x0A762, 0x0A763}, {0x0A764, 0x0A765},
+    {0x0A766, 0x0A767}, {0x0A768, 0x0A769}, {0x0A76A, 0x0A76B}, {0x0A76C, 0x0A76D}, {0x0A76E, 0x0A76F}, {0x0A779, 0x0A77A}, {0x0A77B, 0x0A77C}, {0x0A77D, 0x01D79},
+    {0x0A77E, 0x0A77F}, {0x0A780, 0x0A781}, {0x0A782, 0x0A783}, {0x0A784, 0x0A785}, {0x0A786, 0x0A787}, {0x0A78B, 0x0A78C}, {0x0A78D, 0x00265}, {0x0A790, 0x0A791},
+    {0x0A792, 0x0A793}, {0x0A796, 0x0A797}, {0x0A798, 0x0A799}, {0x0A79A, 0x0A79B}, {0x0A79C, 0x0A79D}, {0x0A79E, 0x0A79F}, {0x0A7A0, 0x0A7A1}, {0x0A7A2, 0x0A7A3},
+    {0x0A7A4, 0x0A7A5}, {0x0A7A6, 0x0A7A7}, {0x0A7A8, 0x0A7A9}, {0x0A7AA, 0x00266}, {0x0A7AB, 0x0025C}, {0x0A7AC, 0x00261}, {0x0A7AD, 0x0026C}, {0x0A7AE, 0x0026A},
+    {0x0A7B0, 0x0029E}, {0x0A7B1, 0x00287}, {0x0A7B2, 0x0029D}, {0x0A7B3, 0x0AB53}, {0x0A7B4, 0x0A7B5}, {0x0A7B6, 0x0A7B7}, {0x0A7B8, 0x0A7B9}, {0x0A7BA, 0x0A7BB},
+    {0x0A7BC, 0x0A7BD}, {0x0A7BE, 0x0A7BF}, {0x0A7C0, 0x0A7C1}, {0x0A7C2, 0x0A7C3}, {0x0A7C4, 0x0A794}, {0x0A7C5, 0x00282}, {0x0A7C6, 0x01D8E}, {0x0A7C7, 0x0A7C8},
+    {0x0A7C9, 0x0A7CA}, {0x0A7D0, 0x0A7D1}, {0x0A7D6, 0x0A7D7}, {0x0A7D8, 0x0A7D9}, {0x0A7F5, 0x0A7F6}, {0x0F900, 0x08C48}, {0x0F901, 0x066F4}, {0x0F902, 0x08ECA},
+    {0x0F903, 0x08CC8}, {0x0F904, 0x06ED1}, {0x0F905, 0x04E32}, {0x0F906, 0x053E5}, {0x0F907, 0x09F9C}, {0x0F908, 0x09F9C}, {0x0F909, 0x05951}, {0x0F90A, 0x091D1},
+    {0x0F90B, 0x05587}, {0x0F90C, 0x05948}, {0x0F90D, 0x061F6}, {0x0F90E, 0x07669}, {0x0F90F, 0x07F85}, {0x0F910, 0x0863F}, {0x0F911, 0x087BA}, {0x0F912, 0x088F8},
+    {0x0F913, 0x0908F}, {0x0F914, 0x06A02}, {0x0F915, 0x06D1B}, {0x0F916, 0x070D9}, {0x0F917, 0x073DE}, {0x0F918, 0x0843D}, {0x0F919, 0x0916A}, {0x0F91A, 0x099F1},
+    {0x0F91B, 0x04E82}, {0x0F91C, 0x05375}, {0x0F91D, 0x06B04}, {0x0F91E, 0x0721B}, {0x0F91F, 0x0862D}, {0x0F920, 0x09E1E}, {0x0F921, 0x05D50}, {0x0F922, 0x06FEB},
+    {0x0F923, 0x085CD}, {0x0F924, 0x08964}, {0x0F925, 0x062C9}, {0x0F926, 0x081D8}, {0x0F927, 0x0881F}, {0x0F928, 0x05ECA}, {0x0F929, 0x06717}, {0x0F92A, 0x06D6A},
+    {0x0F92B, 0x072FC}, {0x0F92C, 0x090CE}, {0x0F92D, 0x04F86}, {0x0F92E, 0x051B7}, {0x0F92F, 0x052DE}, {0x0F930, 0x064C4}, {0x0F931, 0x06AD3}, {0x0F932, 0x07210},
+    {0x0F933, 0x076E7}, {0x0F934, 0x08001}, {0x0F935, 0x08606}, {0x0F936, 0x0865C}, {0x0F937, 0x08DEF}, {0x0F938, 0x09732}, {0x0F939, 0x09B6F}, {0x0F93A, 0x09DFA},
+    {0x0F93B, 0x0788C}, {0x0F93C, 0x0797F}, {0x0F93D, 0x07DA0}, {0x0F93E, 0x083C9}, {0x0F93F, 0x09304}, {0x0F940, 0x09E7F}, {0x0F941, 0x08AD6}, {0x0F942, 0x058DF},
+    {0x0F943, 0x05F04}, {0x0F944, 0x07C60}, {0x0F945, 0x0807E}, {0x0F946, 0x07262}, {0x0F947, 0x078CA}, {0x0F948, 0x08CC2}, {0x0F949, 0x096F7}, {0x0F94A, 0x058D8},
+    {0x0F94B, 0x05C62}, {0x0F94C, 0x06A13}, {0x0F94D, 0x06DDA}, {0x0F94E, 0x06F0F}, {0x0F94F, 0x07D2F}, {0x0F950, 0x07E37}, {0x0F951, 0x0964B}, {0x0F952, 0x052D2},
+    {0x0F953, 0x0808B}, {0x0F954, 0x051DC}, {0x0F955, 0x051CC}, {0x0F956, 0x07A1C}, {0x0F957, 0x07DBE}, {0x0F958, 0x083F1}, {0x0F959, 0x09675}, {0x0F95A, 0x08B80},
+    {0x0F95B, 0x062CF}, {0x0F95C, 0x06A02}, {0x0F95D, 0x08AFE}, {0x0F95E, 0x04E39}, {0x0F95F, 0x05BE7}, {0x0F960, 0x06012}, {0x0F961, 0x07387}, {0x0F962, 0x07570},
+    {0x0F963, 0x05317}, {0x0F964, 0x078FB}, {0x0F965, 0x04FBF}, {0x0F966, 0x05FA9}, {0x0F967, 0x04E0D}, {0x0F968, 0x06CCC}, {0x0F969, 0x06578}, {0x0F96A, 0x07D22},
+    {0x0F96B, 0x053C3}, {0x0F96C, 0x0585E}, {0x0F96D, 0x07701}, {0x0F96E, 0x08449}, {0x0F96F, 0x08AAA}, {0x0F970, 0x06BBA}, {0x0F971, 0x08FB0}, {0x0F972, 0x06C88},
+    {0x0F973, 0x062FE}, {0x0F974, 0x082E5}, {0x0F975, 0x063A0}, {0x0F976, 0x07565}, {0x0F977, 0x04EAE}, {0x0F978, 0x05169}, {0x0F979, 0x051C9}, {0x0F97A, 0x06881},
+    {0x0F97B, 0x07CE7}, {0x0F97C, 0x0826F}, {0x0F97D, 0x08AD2}, {0x0F97E, 0x091CF}, {0x0F97F, 0x052F5}, {0x0F980, 0x05442}, {0x0F981, 0x05973}, {0x0F982, 0x05EEC},
+    {0x0F983, 0x065C5}, {0x0F984, 0x06FFE}, {0x0F985, 0x0792A}, {0x0F986, 0x095AD}, {0x0F987, 0x09A6A}, {0x0F988, 0x09E97}, {0x0F989, 0x09ECE}, {0x0F98A, 0x0529B},
+    {0x0F98B, 0x066C6}, {0x0F98C, 0x06B77}, {0x0F98D, 0x08F62}, {0x0F98E, 0x05E74}, {0x0F98F, 0x06190}, {0x0F990, 0x06200}, {0x0F991, 0x0649A}, {0x0F992, 0x06F23},
+    {0x0F993, 0x07149}, {0x0F994, 0x07489}, {0x0F995, 0x079CA}, {0x0F996, 0x07DF4}, {0x0F997, 0x0806F}, {0x0F998, 0x08F26}, {0x0F999, 0x084EE}, {0x0F99A, 0x09023},
+    {0x0F99B, 0x0934A}, {0x0F99C, 0x05217}, {0x0F99D, 0x052A3}, {0x0F99E, 0x054BD}, {0x0F99F, 0x070C8}, {0x0F9A0, 0x088C2}, {0x0F9A1, 0x08AAA}, {0x0F9A2, 0x05EC9},
+    {0x0F9A3, 0x05FF5}, {0x0F9A4, 0x0637B}, {0x0F9A5, 0x06BAE}, {0x0F9A6, 0x07C3E}, {0x0F9A7, 0x07375}, {0x0F9A8, 0x04EE4}, {0x0F9A9, 0x056F9}, {0x0F9AA, 0x05BE7},
+    {0x0F9AB, 0x05DBA}, {0x0F9AC, 0x0601C}, {0x0F9AD, 0x073B2}, {0x0F9AE, 0x07469}, {0x0F9AF, 0x07F9A}, {0x0F9B0, 0x08046}, {0x0F9B1, 0x09234}, {0x0F9B2, 0x096F6},
+    {0x0F9B3, 0x09748}, {0x0F9B4, 0x09818}, {0x0F9B5, 0x04F8B}, {0x0F9B6, 0x079AE}, {0x0F9B7, 0x091B4}, {0x0F9B8, 0x096B8}, {0x0F9B9, 0x060E1}, {0x0F9BA, 0x04E86},
+    {0x0F9BB, 0x050DA}, {0x0F9BC, 0x05BEE}, {0x0F9BD, 0x05C3F}, {0x0F9BE, 0x06599}, {0x0F9BF, 0x06A02}, {0x0F9C0, 0x071CE}, {0x0F9C1, 0x07642}, {0x0F9C2, 0x084FC},
+    {0x0F9C3, 0x0907C}, {0x0F9C4, 0x09F8D}, {0x0F9C5, 0x06688}, {0x0F9C6, 0x0962E}, {0x0F9C7, 0x05289}, {0x0F9C8, 0x0677B}, {0x0F9C9, 0x067F3}, {0x0F9CA, 0x06D41},
+    {0x0F9CB, 0x06E9C}, {0x0F9CC, 0x07409}, {0x0F9CD, 0x07559}, {0x0F9CE, 0x0786B}, {0x0F9CF, 0x07D10}, {0x0F9D0, 0x0985E}, {0x0F9D1, 0x0516D}, {0x0F9D2, 0x0622E},
+    {0x0F9D3, 0x09678}, {0x0F9D4, 0x0502B}, {0x0F9D5, 0x05D19}, {0x0F9D6, 0x06DEA}, {0x0F9D7, 0x08F2A}, {0x0F9D8, 0x05F8B}, {0x0F9D9, 0x06144}, {0x0F9DA, 0x06817},
+    {0x0F9DB, 0x07387}, {0x0F9DC, 0x09686}, {0x0F9DD, 0x05229}, {0x0F9DE, 0x0540F}, {0x0F9DF, 0x05C65}, {0x0F9E0, 0x06613}, {0x0F9E1, 0x0674E}, {0x0F9E2, 0x068A8},
+    {0x0F9E3, 0x06CE5}, {0x0F9E4, 0x07406}, {0x0F9E5, 0x075E2}, {0x0F9E6, 0x07F79}, {0x0F9E7, 0x088CF}, {0x0F9E8, 0x088E1}, {0x0F9E9, 0x091CC}, {0x0F9EA, 0x096E2},
+    {0x0F9EB, 0x0533F}, {0x0F9EC, 0x06EBA}, {0x0F9ED, 0x0541D}, {0x0F9EE, 0x071D0}, {0x0F9EF, 0x07498}, {0x0F9F0, 0x085FA}, {0x0F9F1, 0x096A3}, {0x0F9F2, 0x09C57},
+    {0x0F9F3, 0x09E9F}, {0x0F9F4, 0x06797}, {0x0F9F5, 0x06DCB}, {0x0F9F6, 0x081E8}, {0x0F9F7, 0x07ACB}, {0x0F9F8, 0x07B20}, {0x0F9F9, 0x07C92}, {0x0F9FA, 0x072C0},
+    {0x0F9FB, 0x07099}, {0x0F9FC, 0x08B58}, {0x0F9FD, 0x04EC0}, {0x0F9FE, 0x08336}, {0x0F9FF, 0x0523A}, {0x0FA00, 0x05207}, {0x0FA01, 0x05EA6}, {0x0FA02, 0x062D3},
+    {0x0FA03, 0x07CD6}, {0x0FA04, 0x05B85}, {0x0FA05, 0x06D1E}, {0x0FA06, 0x066B4}, {0x0FA07, 0x08F3B}, {0x0FA08, 0x0884C}, {0x0FA09, 0x0964D}, {0x0FA0A, 0x0898B},
+    {0x0FA0B, 0x05ED3}, {0x0FA0C, 0x05140}, {0x0FA0D, 0x055C0}, {0x0FA10, 0x0585A}, {0x0FA12, 0x06674}, {0x0FA15, 0x051DE}, {0x0FA16, 0x0732A}, {0x0FA17, 0x076CA},
+    {0x0FA18, 0x0793C}, {0x0FA19, 0x0795E}, {0x0FA1A, 0x07965}, {0x0FA1B, 0x0798F}, {0x0FA1C, 0x09756}, {0x0FA1D, 0x07CBE}, {0x0FA1E, 0x07FBD}, {0x0FA20, 0x08612},
+    {0x0FA22, 0x08AF8}, {0x0FA25, 0x09038}, {0x0FA26, 0x090FD}, {0x0FA2A, 0x098EF}, {0x0FA2B, 0x098FC}, {0x0FA2C, 0x09928}, {0x0FA2D, 0x09DB4}, {0x0FA2E, 0x090DE},
+    {0x0FA2F, 0x096B7}, {0x0FA30, 0x04FAE}, {0x0FA31, 0x050E7}, {0x0FA32, 0x0514D}, {0x0FA33, 0x052C9}, {0x0FA34, 0x052E4}, {0x0FA35, 0x05351}, {0x0FA36, 0x0559D},
+    {0x0FA37, 0x05606}, {0x0FA38, 0x05668}, {0x0FA39, 0x05840}, {0x0FA3A, 0x058A8}, {0x0FA3B, 0x05C64}, {0x0FA3C, 0x05C6E}, {0x0FA3D, 0x06094}, {0x0FA3E, 0x06168},
+    {0x0FA3F, 0x0618E}, {0x0FA40, 0x061F2}, {0x0FA41, 0x0654F}, {0x0FA42, 0x065E2}, {0x0FA43, 0x06691}, {0x0FA44, 0x06885}, {0x0FA45, 0x06D77}, {0x0FA46, 0x06E1A},
+    {0x0FA47, 0x06F22}, {0x0FA48, 0x0716E}, {0x0FA49, 0x0722B}, {0x0FA4A, 0x07422}, {0x0FA4B, 0x07891}, {0x0FA4C, 0x0793E}, {0x0FA4D, 0x07949}, {0x0FA4E, 0x07948},
+    {0x0FA4F, 0x07950}, {0x0FA50, 0x07956}, {0x0FA51, 0x0795D}, {0x0FA52, 0x0798D}, {0x0FA53, 0x0798E}, {0x0FA54, 0x07A40}, {0x0FA55, 0x07A81}, {0x0FA56, 0x07BC0},
+    {0x0FA57, 0x07DF4}, {0x0FA58, 0x07E09}, {0x0FA59, 0x07E41}, {0x0FA5A, 0x07F72}, {0x0FA5B, 0x08005}, {0x0FA5C, 0x081ED}, {0x0FA5D, 0x08279}, {0x0FA5E, 0x08279},
+    {0x0FA5F, 0x08457}, {0x0FA60, 0x08910}, {0x0FA61, 0x08996}, {0x0FA62, 0x08B01}, {0x0FA63, 0x08B39}, {0x0FA64, 0x08CD3}, {0x0FA65, 0x08D08}, {0x0FA66, 0x08FB6},
+    {0x0FA67, 0x09038}, {0x0FA68, 0x096E3}, {0x0FA69, 0x097FF}, {0x0FA6A, 0x0983B}, {0x0FA6B, 0x06075}, {0x0FA6C, 0x242EE}, {0x0FA6D, 0x08218}, {0x0FA70, 0x04E26},
+    {0x0FA71, 0x051B5}, {0x0FA72, 0x05168}, {0x0FA73, 0x04F80}, {0x0FA74, 0x05145}, {0x0FA75, 0x05180}, {0x0FA76, 0x052C7}, {0x0FA77, 0x052FA}, {0x0FA78, 0x0559D},
+    {0x0FA79, 0x05555}, {0x0FA7A, 0x05599}, {0x0FA7B, 0x055E2}, {0x0FA7C, 0x0585A}, {0x0FA7D, 0x058B3}, {0x0FA7E, 0x05944}, {0x0FA7F, 0x05954}, {0x0FA80, 0x05A62},
+    {0x0FA81, 0x05B28}, {0x0FA82, 0x05ED2}, {0x0FA83, 0x05ED9}, {0x0FA84, 0x05F69}, {0x0FA85, 0x05FAD}, {0x0FA86, 0x060D8}, {0x0FA87, 0x0614E}, {0x0FA88, 0x06108},
+    {0x0FA89, 0x0618E}, {0x0FA8A, 0x06160}, {0x0FA8B, 0x061F2}, {0x0FA8C, 0x06234}, {0x0FA8D, 0x063C4}, {0x0FA8E, 0x0641C}, {0x0FA8F, 0x06452}, {0x0FA90, 0x06556},
+    {0x0FA91, 0x06674}, {0x0FA92, 0x06717}, {0x0FA93, 0x0671B}, {0x0FA94, 0x06756}, {0x0FA95, 0x06B79}, {0x0FA96, 0x06BBA}, {0x0FA97, 0x06D41}, {0x0FA98, 0x06EDB},
+    {0x0FA99, 0x06ECB}, {0x0FA9A, 0x06F22}, {0x0FA9B, 0x0701E}, {0x0FA9C, 0x0716E}, {0x0FA9D, 0x077A7}, {0x0FA9E, 0x07235}, {0x0FA9F, 0x072AF}, {0x0FAA0, 0x0732A},
+    {0x0FAA1, 0x07471}, {0x0FAA2, 0x07506}, {0x0FAA3, 0x0753B}, {0x0FAA4, 0x0761D}, {0x0FAA5, 0x0761F}, {0x0FAA6, 0x076CA}, {0x0FAA7, 0x076DB}, {0x0FAA8, 0x076F4},
+    {0x0FAA9, 0x0774A}, {0x0FAAA, 0x07740}, {0x0FAAB, 0x078CC}, {0x0FAAC, 0x07AB1}, {0x0FAAD, 0x07BC0}, {0x0FAAE, 0x07C7B}, {0x0FAAF, 0x07D5B}, {0x0FAB0, 0x07DF4},
+    {0x0FAB1, 0x07F3E}, {0x0FAB2, 0x08005}, {0x0FAB3, 0x08352}, {0x0FAB4, 0x083EF}, {0x0FAB5, 0x08779}, {0x0FAB6, 0x08941}, {0x0FAB7, 0x08986}, {0x0FAB8, 0x08996},
+    {0x0FAB9, 0x08ABF}, {0x0FABA, 0x08AF8}, {0x0FABB, 0x08ACB}, {0x0FABC, 0x08B01}, {0x0FABD, 0x08AFE}, {0x0FABE, 0x08AED}, {0x0FABF, 0x08B39}, {0x0FAC0, 0x08B8A},
+    {0x0FAC1, 0x08D08}, {0x0FAC2, 0x08F38}, {0x0FAC3, 0x09072}, {0x0FAC4, 0x09199}, {0x0FAC5, 0x09276}, {0x0FAC6, 0x0967C}, {0x0FAC7, 0x096E3}, {0x0FAC8, 0x09756},
+    {0x0FAC9, 0x097DB}, {0x0FACA, 0x097FF}, {0x0FACB, 0x0980B}, {0x0FACC, 0x0983B}, {0x0FACD, 0x09B12}, {0x0FACE, 0x09F9C}, {0x0FACF, 0x2284A}, {0x0FAD0, 0x22844},
+    {0x0FAD1, 0x233D5}, {0x0FAD2, 0x03B9D}, {0x0FAD3, 0x04018}, {0x0FAD4, 0x04039}, {0x0FAD5, 0x25249}, {0x0FAD6, 0x25CD0}, {0x0FAD7, 0x27ED3}, {0x0FAD8, 0x09F43},
+    {0x0FAD9, 0x09F8E}, {0x0FB1D, 0x005D9}, {0x0FB1F, 0x005F2}, {0x0FB2A, 0x005E9}, {0x0FB2B, 0x005E9}, {0x0FB2C, 0x005E9}, {0x0FB2D, 0x005E9}, {0x0FB2E, 0x005D0},
+    {0x0FB2F, 0x005D0}, {0x0FB30, 0x005D0}, {0x0FB31, 0x005D1}, {0x0FB32, 0x005D2}, {0x0FB33, 0x005D3}, {0x0FB34, 0x005D4}, {0x0FB35, 0x005D5}, {0x0FB36, 0x005D6},
+    {0x0FB38, 0x005D8}, {0x0FB39, 0x005D9}, {0x0FB3A, 0x005DA}, {0x0FB3B, 0x005DB}, {0x0FB3C, 0x005DC}, {0x0FB3E, 0x005DE}, {0x0FB40, 0x005E0}, {0x0FB41, 0x005E1},
+    {0x0FB43, 0x005E3}, {0x0FB44, 0x005E4}, {0x0FB46, 0x005E6}, {0x0FB47, 0x005E7}, {0x0FB48, 0x005E8}, {0x0FB49, 0x005E9}, {0x0FB4A, 0x005EA}, {0x0FB4B, 0x005D5},
+    {0x0FB4C, 0x005D1}, {0x0FB4D, 0x005DB}, {0x0FB4E, 0x005E4}, {0x0FF21, 0x0FF41}, {0x0FF22, 0x0FF42}, {0x0FF23, 0x0FF43}, {0x0FF24, 0x0FF44}, {0x0FF25, 0x0FF45},
+    {0x0FF26, 0x0FF46}, {0x0FF27, 0x0FF47}, {0x0FF28, 0x0FF48}, {0x0FF29, 0x0FF49}, {0x0FF2A, 0x0FF4A}, {0x0FF2B, 0x0FF4B}, {0x0FF2C, 0x0FF4C}, {0x0FF2D, 0x0FF4D},
+    {0x0FF2E, 0x0FF4E}, {0x0FF2F, 0x0FF4F}, {0x0FF30, 0x0FF50}, {0x0FF31, 0x0FF51}, {0x0FF32, 0x0FF52}, {0x0FF33, 0x0FF53}, {0x0FF34, 0x0FF54}, {0x0FF35, 0x0FF55},
+    {0x0FF36, 0x0FF56}, {0x0FF37, 0x0FF57}, {0x0FF38, 0x0FF58}, {0x0FF39, 0x0FF59}, {0x0FF3A, 0x0FF5A}, {0x10400, 0x10428}, {0x10401, 0x10429}, {0x10402, 0x1042A},
+    {0x10403, 0x1042B}, {0x10404, 0x1042C}, {0x10405, 0x1042D}, {0x10406, 0x1042E}, {0x10407, 0x1042F}, {0x10408, 0x10430}, {0x10409, 0x10431}, {0x1040A, 0x10432},
+    {0x1040B, 0x10433}, {0x1040C, 0x10434}, {0x1040D, 0x10435}, {0x1040E, 0x10436}, {0x1040F, 0x10437}, {0x10410, 0x10438}, {0x10411, 0x10439}, {0x10412, 0x1043A},
+    {0x10413, 0x1043B}, {0x10414, 0x1043C}, {0x10415, 0x1043D}, {0x10416, 0x1043E}, {0x10417, 0x1043F}, {0x10418, 0x10440}, {0x10419, 0x10441}, {0x1041A, 0x10442},
+    {0x1041B, 0x10443}, {0x1041C, 0x10444}, {0x1041D, 0x10445}, {0x1041E, 0x10446}, {0x1041F, 0x10447}, {0x10420, 0x10448}, {0x10421, 0x10449}, {0x10422, 0x1044A},
+    {0x10423, 0x1044B}, {0x10424, 0x1044C}, {0x10425, 0x1044D}, {0x10426, 0x1044E}, {0x10427, 0x1044F}, {0x104B0, 0x104D8}, {0x104B1, 0x104D9}, {0x104B2, 0x104DA},
+    {0x104B3, 0x104DB}, {0x104B4, 0x104DC}, {0x104B5, 0x104DD}, {0x104B6, 0x104DE}, {0x104B7, 0x104DF}, {0x104B8, 0x104E0}, {0x104B9, 0x104E1}, {0x104BA, 0x104E2},
+    {0x104BB, 0x104E3}, {0x104BC, 0x104E4}, {0x104BD, 0x104E5}, {0x104BE, 0x104E6}, {0x104BF, 0x104E7}, {0x104C0, 0x104E8}, {0x104C1, 0x104E9}, {0x104C2, 0x104EA},
+    {0x104C3, 0x104EB}, {0x104C4, 0x104EC}, {0x104C5, 0x104ED}, {0x104C6, 0x104EE}, {0x104C7, 0x104EF}, {0x104C8, 0x104F0}, {0x104C9, 0x104F1}, {0x104CA, 0x104F2},
+    {0x104CB, 0x104F3}, {0x104CC, 0x104F4}, {0x104CD, 0x104F5}, {0x104CE, 0x104F6}, {0x104CF, 0x104F7}, {0x104D0, 0x104F8}, {0x104D1, 0x104F9}, {0x104D2, 0x104FA},
+    {0x104D3, 0x104FB}, {0x10570, 0x10597}, {0x10571, 0x10598}, {0x10572, 0x10599}, {0x10573, 0x1059A}, {0x10574, 0x1059B}, {0x10575, 0x1059C}, {0x10576, 0x1059D},
+    {0x10577, 0x1059E}, {0x10578, 0x1059F}, {0x10579, 0x105A0}, {0x1057A, 0x105A1}, {0x1057C, 0x105A3}, {0x1057D, 0x105A4}, {0x1057E, 0x105A5}, {0x1057F, 0x105A6},
+    {0x10580, 0x105A7}, {0x10581, 0x105A8}, {0x10582, 0x105A9}, {0x10583, 0x105AA}, {0x10584, 0x105AB}, {0x10585, 0x105AC}, {0x10586, 0x105AD}, {0x10587, 0x105AE},
+    {0x10588, 0x105AF}, {0x10589, 0x105B0}, {0x1058A, 0x105B1}, {0x1058C, 0x105B3}, {0x1058D, 0x105B4}, {0x1058E, 0x105B5}, {0x1058F, 0x105B6}, {0x10590, 0x105B7},
+    {0x10591, 0x105B8}, {0x10592, 0x105B9}, {0x10594, 0x105BB}, {0x10595, 0x105BC}, {0x10C80, 0x10CC0}, {0x10C81, 0x10CC1}, {0x10C82, 0x10CC2}, {0x10C83, 0x10CC3},
+    {0x10C84, 0x10CC4}, {0x10C85, 0x10CC5}, {0x10C86, 0x10CC6}, {0x10C87, 0x10CC7}, {0x10C88, 0x10CC8}, {0x10C89, 0x10CC9}, {0x10C8A, 0x10CCA}, {0x10C8B, 0x10CCB},
+    {0x10C8C, 0x10CCC}, {0x10C8D, 0x10CCD}, {0x10C8E, 0x10CCE}, {0x10C8F, 0x10CCF}, {0x10C90, 0x10CD0}, {0x10C91, 0x10CD1}, {0x10C92, 0x10CD2}, {0x10C93, 0x10CD3},
+    {0x10C94, 0x10CD4}, {0x10C95, 0x10CD5}, {0x10C96, 0x10CD6}, {0x10C97, 0x10CD7}, {0x10C98, 0x10CD8}, {0x10C99, 0x10CD9}, {0x10C9A, 0x10CDA}, {0x10C9B, 0x10CDB},
+    {0x10C9C, 0x10CDC}, {0x10C9D, 0x10CDD}, {0x10C9E, 0x10CDE}, {0x10C9F, 0x10CDF}, {0x10CA0, 0x10CE0}, {0x10CA1, 0x10CE1}, {0x10CA2, 0x10CE2}, {0x10CA3, 0x10CE3},
+    {0x10CA4, 0x10CE4}, {0x10CA5, 0x10CE5}, {0x10CA6, 0x10CE6}, {0x10CA7, 0x10CE7}, {0x10CA8, 0x10CE8}, {0x10CA9, 0x10CE9}, {0x10CAA, 0x10CEA}, {0x10CAB, 0x10CEB},
+    {0x10CAC, 0x10CEC}, {0x10CAD, 0x10CED}, {0x10CAE, 0x10CEE}, {0x10CAF, 0x10CEF}, {0x10CB0, 0x10CF0}, {0x10CB1, 0x10CF1}, {0x10CB2, 0x10CF2}, {0x1109A, 0x11099},
+    {0x1109C, 0x1109B}, {0x110AB, 0x110A5}, {0x114BB, 0x114B9}, {0x118A0, 0x118C0}, {0x118A1, 0x118C1}, {0x118A2, 0x118C2}, {0x118A3, 0x118C3}, {0x118A4, 0x118C4},
+    {0x118A5, 0x118C5}, {0x118A6, 0x118C6}, {0x118A7, 0x118C7}, {0x118A8, 0x118C8}, {0x118A9, 0x118C9}, {0x118AA, 0x118CA}, {0x118AB, 0x118CB}, {0x118AC, 0x118CC},
+    {0x118AD, 0x118CD}, {0x118AE, 0x118CE}, {0x118AF, 0x118CF}, {0x118B0, 0x118D0}, {0x118B1, 0x118D1}, {0x118B2, 0x118D2}, {0x118B3, 0x118D3}, {0x118B4, 0x118D4},
+    {0x118B5, 0x118D5}, {0x118B6, 0x118D6}, {0x118B7, 0x118D7}, {0x118B8, 0x118D8}, {0x118B9, 0x118D9}, {0x118BA, 0x118DA}, {0x118BB, 0x118DB}, {0x118BC, 0x118DC},
+    {0x118BD, 0x118DD}, {0x118BE, 0x118DE}, {0x118BF, 0x118DF}, {0x16E40, 0x16E60}, {0x16E41, 0x16E61}, {0x16E42, 0x16E62}, {0x16E43, 0x16E63}, {0x16E44, 0x16E64},
+    {0x16E45, 0x16E65}, {0x16E46, 0x16E66}, {0x16E47, 0x16E67}, {0x16E48, 0x16E68}, {0x16E49, 0x16E69}, {0x16E4A, 0x16E6A}, {0x16E4B, 0x16E6B}, {0x16E4C, 0x16E6C},
+    {0x16E4D, 0x16E6D}, {0x16E4E, 0x16E6E}, {0x16E4F, 0x16E6F}, {0x16E50, 0x16E70}, {0x16E51, 0x16E71}, {0x16E52, 0x16E72}, {0x16E53, 0x16E73}, {0x16E54, 0x16E74},
+    {0x16E55, 0x16E75}, {0x16E56, 0x16E76}, {0x16E57, 0x16E77}, {0x16E58, 0x16E78}, {0x16E59, 0x16E79}, {0x16E5A, 0x16E7A}, {0x16E5B, 0x16E7B}, {0x16E5C, 0x16E7C},
+    {0x16E5D, 0x16E7D}, {0x16E5E, 0x16E7E}, {0x16E5F, 0x16E7F}, {0x1E900, 0x1E922}, {0x1E901, 0x1E923}, {0x1E902, 0x1E924}, {0x1E903, 0x1E925}, {0x1E904, 0x1E926},
+    {0x1E905, 0x1E927}, {0x1E906, 0x1E928}, {0x1E907, 0x1E929}, {0x1E908, 0x1E92A}, {0x1E909, 0x1E92B}, {0x1E90A, 0x1E92C}, {0x1E90B, 0x1E92D}, {0x1E90C, 0x1E92E},
+    {0x1E90D, 0x1E92F}, {0x1E90E, 0x1E930}, {0x1E90F, 0x1E931}, {0x1E910, 0x1E932}, {0x1E911, 0x1E933}, {0x1E912, 0x1E934}, {0x1E913, 0x1E935}, {0x1E914, 0x1E936},
+    {0x1E915, 0x1E937}, {0x1E916, 0x1E938}, {0x1E917, 0x1E939}, {0x1E918, 0x1E93A}, {0x1E919, 0x1E93B}, {0x1E91A, 0x1E93C}, {0x1E91B, 0x1E93D}, {0x1E91C, 0x1E93E},
+    {0x1E91D, 0x1E93F}, {0x1E91E, 0x1E940}, {0x1E91F, 0x1E941}, {0x1E920, 0x1E942}, {0x1E921, 0x1E943}, {0x2F800, 0x04E3D}, {0x2F801, 0x04E38}, {0x2F802, 0x04E41},
+    {0x2F803, 0x20122}, {0x2F804, 0x04F60}, {0x2F805, 0x04FAE}, {0x2F806, 0x04FBB}, {0x2F807, 0x05002}, {0x2F808, 0x0507A}, {0x2F809, 0x05099}, {0x2F80A, 0x050E7},
+    {0x2F80B, 0x050CF}, {0x2F80C, 0x0349E}, {0x2F80D, 0x2063A}, {0x2F80E, 0x0514D}, {0x2F80F, 0x05154}, {0x2F810, 0x05164}, {0x2F811, 0x05177}, {0x2F812, 0x2051C},
+    {0x2F813, 0x034B9}, {0x2F814, 0x05167}, {0x2F815, 0x0518D}, {0x2F816, 0x2054B}, {0x2F817, 0x05197}, {0x2F818, 0x051A4}, {0x2F819, 0x04ECC}, {0x2F81A, 0x051AC},
+    {0x2F81B, 0x051B5}, {0x2F81C, 0x291DF}, {0x2F81D, 0x051F5}, {0x2F81E, 0x05203}, {0x2F81F, 0x034DF}, {0x2F820, 0x0523B}, {0x2F821, 0x05246}, {0x2F822, 0x05272},
+    {0x2F823, 0x05277}, {0x2F824, 0x03515}, {0x2F825, 0x052C7}, {0x2F826, 0x052C9}, {0x2F827, 0x052E4}, {0x2F828, 0x052FA}, {0x2F829, 0x05305}, {0x2F82A, 0x05306},
+    {0x2F82B, 0x05317}, {0x2F82C, 0x05349}, {0x2F82D, 0x05351}, {0x2F82E, 0x0535A}, {0x2F82F, 0x05373}, {0x2F830, 0x0537D}, {0x2F831, 0x0537F}, {0x2F832, 0x0537F},
+    {0x2F833, 0x0537F}, {0x2F834, 0x20A2C}, {0x2F835, 0x07070}, {0x2F836, 0x053CA}, {0x2F837, 0x053DF}, {0x2F838, 0x20B63}, {0x2F839, 0x053EB}, {0x2F83A, 0x053F1},
+    {0x2F83B, 0x05406}, {0x2F83C, 0x0549E}, {0x2F83D, 0x05438}, {0x2F83E, 0x05448}, {0x2F83F, 0x05468}, {0x2F840, 0x054A2}, {0x2F841, 0x054F6}, {0x2F842, 0x05510},
+    {0x2F843, 0x05553}, {0x2F844, 0x05563}, {0x2F845, 0x05584}, {0x2F846, 0x05584}, {0x2F847, 0x05599}, {0x2F848, 0x055AB}, {0x2F849, 0x055B3}, {0x2F84A, 0x055C2},
+    {0x2F84B, 0x05716}, {0x2F84C, 0x05606}, {0x2F84D, 0x05717}, {0x2F84E, 0x05651}, {0x2F84F, 0x05674}, {0x2F850, 0x05207}, {0x2F851, 0x058EE}, {0x2F852, 0x057CE},
+    {0x2F853, 0x057F4}, {0x2F854, 0x0580D}, {0x2F855, 0x0578B}, {0x2F856, 0x05832}, {0x2F857, 0x05831}, {0x2F858, 0x058AC}, {0x2F859, 0x214E4}, {0x2F85A, 0x058F2},
+    {0x2F85B, 0x058F7}, {0x2F85C, 0x05906}, {0x2F85D, 0x0591A}, {0x2F85E, 0x05922}, {0x2F85F, 0x05962}, {0x2F860, 0x216A8}, {0x2F861, 0x216EA}, {0x2F862, 0x059EC},
+    {0x2F863, 0x05A1B}, {0x2F864, 0x05A27}, {0x2F865, 0x059D8}, {0x2F866, 0x05A66}, {0x2F867, 0x036EE}, {0x2F868, 0x036FC}, {0x2F869, 0x05B08}, {0x2F86A, 0x05B3E},
+    {0x2F86B, 0x05B3E}, {0x2F86C, 0x219C8}, {0x2F86D, 0x05BC3}, {0x2F86E, 0x05BD8}, {0x2F86F, 0x05BE7}, {0x2F870, 0x05BF3}, {0x2F871, 0x21B18}, {0x2F872, 0x05BFF},
+    {0x2F873, 0x05C06}, {0x2F874, 0x05F53}, {0x2F875, 0x05C22}, {0x2F876, 0x03781}, {0x2F877, 0x05C60}, {0x2F878, 0x05C6E}, {0x2F879, 0x05CC0}, {0x2F87A, 0x05C8D},
+    {0x2F87B, 0x21DE4}, {0x2F87C, 0x05D43}, {0x2F87D, 0x21DE6}, {0x2F87E, 0x05D6E}, {0x2F87F, 0x05D6B}, {0x2F880, 0x05D7C}, {0x2F881, 0x05DE1}, {0x2F882, 0x05DE2},
+    {0x2F883, 0x0382F}, {0x2F884, 0x05DFD}, {0x2F885, 0x05E28}, {0x2F886, 0x05E3D}, {0x2F887, 0x05E69}, {0x2F888, 0x03862}, {0x2F889, 0x22183}, {0x2F88A, 0x0387C},
+    {0x2F88B, 0x05EB0}, {0x2F88C, 0x05EB3}, {0x2F88D, 0x05EB6}, {0x2F88E, 0x05ECA}, {0x2F88F, 0x2A392}, {0x2F890, 0x05EFE}, {0x2F891, 0x22331}, {0x2F892, 0x22331},
+    {0x2F893, 0x08201}, {0x2F894, 0x05F22}, {0x2F895, 0x05F22}, {0x2F896, 0x038C7}, {0x2F897, 0x232B8}, {0x2F898, 0x261DA}, {0x2F899, 0x05F62}, {0x2F89A, 0x05F6B},
+    {0x2F89B, 0x038E3}, {0x2F89C, 0x05F9A}, {0x2F89D, 0x05FCD}, {0x2F89E, 0x05FD7}, {0x2F89F, 0x05FF9}, {0x2F8A0, 0x06081}, {0x2F8A1, 0x0393A}, {0x2F8A2, 0x0391C},
+    {0x2F8A3, 0x06094}, {0x2F8A4, 0x226D4}, {0x2F8A5, 0x060C7}, {0x2F8A6, 0x06148}, {0x2F8A7, 0x0614C}, {0x2F8A8, 0x0614E}, {0x2F8A9, 0x0614C}, {0x2F8AA, 0x0617A},
+    {0x2F8AB, 0x0618E}, {0x2F8AC, 0x061B2}, {0x2F8AD, 0x061A4}, {0x2F8AE, 0x061AF}, {0x2F8AF, 0x061DE}, {0x2F8B0, 0x061F2}, {0x2F8B1, 0x061F6}, {0x2F8B2, 0x06210},
+    {0x2F8B3, 0x0621B}, {0x2F8B4, 0x0625D}, {0x2F8B5, 0x062B1}, {0x2F8B6, 0x062D4}, {0x2F8B7, 0x06350}, {0x2F8B8, 0x22B0C}, {0x2F8B9, 0x0633D}, {0x2F8BA, 0x062FC},
+    {0x2F8BB, 0x06368}, {0x2F8BC, 0x06383}, {0x2F8BD, 0x063E4}, {0x2F8BE, 0x22BF1}, {0x2F8BF, 0x06422}, {0x2F8C0, 0x063C5}, {0x2F8C1, 0x063A9}, {0x2F8C2, 0x03A2E},
+    {0x2F8C3, 0x06469}, {0x2F8C4, 0x0647E}, {0x2F8C5, 0x0649D}, {0x2F8C6, 0x06477}, {0x2F8C7, 0x03A6C}, {0x2F8C8, 0x0654F}, {0x2F8C9, 0x0656C}, {0x2F8CA, 0x2300A},
+    {0x2F8CB, 0x065E3}, {0x2F8CC, 0x066F8}, {0x2F8CD, 0x06649}, {0x2F8CE, 0x03B19}, {0x2F8CF, 0x06691}, {0x2F8D0, 0x03B08}, {0x2F8D1, 0x03AE4}, {0x2F8D2, 0x05192},
+    {0x2F8D3, 0x05195}, {0x2F8D4, 0x06700}, {0x2F8D5, 0x0669C}, {0x2F8D6, 0x080AD}, {0x2F8D7, 0x043D9}, {0x2F8D8, 0x06717}, {0x2F8D9, 0x0671B}, {0x2F8DA, 0x06721},
+    {0x2F8DB, 0x0675E}, {0x2F8DC, 0x06753}, {0x2F8DD, 0x233C3}, {0x2F8DE, 0x03B49}, {0x2F8DF, 0x067FA}, {0x2F8E0, 0x06785}, {0x2F8E1, 0x06852}, {0x2F8E2, 0x06885},
+    {0x2F8E3, 0x2346D}, {0x2F8E4, 0x0688E}, {0x2F8E5, 0x0681F}, {0x2F8E6, 0x06914}, {0x2F8E7, 0x03B9D}, {0x2F8E8, 0x06942}, {0x2F8E9, 0x069A3}, {0x2F8EA, 0x069EA},
+    {0x2F8EB, 0x06AA8}, {0x2F8EC, 0x236A3}, {0x2F8ED, 0x06ADB}, {0x2F8EE, 0x03C18}, {0x2F8EF, 0x06B21}, {0x2F8F0, 0x238A7}, {0x2F8F1, 0x06B54}, {0x2F8F2, 0x03C4E},
+    {0x2F8F3, 0x06B72}, {0x2F8F4, 0x06B9F}, {0x2F8F5, 0x06BBA}, {0x2F8F6, 0x06BBB}, {0x2F8F7, 0x23A8D}, {0x2F8F8, 0x21D0B}, {0x2F8F9, 0x23AFA}, {0x2F8FA, 0x06C4E},
+    {0x2F8FB, 0x23CBC}, {0x2F8FC, 0x06CBF}, {0x2F8FD, 0x06CCD}, {0x2F8FE, 0x06C67}, {0x2F8FF, 0x06D16}, {0x2F900, 0x06D3E}, {0x2F901, 0x06D77}, {0x2F902, 0x06D41},
+    {0x2F903, 0x06D69}, {0x2F904, 0x06D78}, {0x2F905, 0x06D85}, {0x2F906, 0x23D1E}, {0x2F907, 0x06D34}, {0x2F908, 0x06E2F}, {0x2F909, 0x06E6E}, {0x2F90A, 0x03D33},
+    {0x2F90B, 0x06ECB}, {0x2F90C, 0x06EC7}, {0x2F90D, 0x23ED1}, {0x2F90E, 0x06DF9}, {0x2F90F, 0x06F6E}, {0x2F910, 0x23F5E}, {0x2F911, 0x23F8E}, {0x2F912, 0x06FC6},
+    {0x2F913, 0x07039}, {0x2F914, 0x0701E}, {0x2F915, 0x0701B}, {0x2F916, 0x03D96}, {0x2F917, 0x0704A}, {0x2F918, 0x0707D}, {0x2F919, 0x07077}, {0x2F91A, 0x070AD},
+    {0x2F91B, 0x20525}, {0x2F91C, 0x07145}, {0x2F91D, 0x24263}, {0x2F91E, 0x0719C}, {0x2F91F, 0x243AB}, {0x2F920, 0x07228}, {0x2F921, 0x07235}, {0x2F922, 0x07250},
+    {0x2F923, 0x24608}, {0x2F924, 0x07280}, {0x2F925, 0x07295}, {0x2F926, 0x24735}, {0x2F927, 0x24814}, {0x2F928, 0x0737A}, {0x2F929, 0x0738B}, {0x2F92A, 0x03EAC},
+    {0x2F92B, 0x073A5}, {0x2F92C, 0x03EB8}, {0x2F92D, 0x03EB8}, {0x2F92E, 0x07447}, {0x2F92F, 0x0745C}, {0x2F930, 0x07471}, {0x2F931, 0x07485}, {0x2F932, 0x074CA},
+    {0x2F933, 0x03F1B}, {0x2F934, 0x07524}, {0x2F935, 0x24C36}, {0x2F936, 0x0753E}, {0x2F937, 0x24C92}, {0x2F938, 0x07570}, {0x2F939, 0x2219F}, {0x2F93A, 0x07610},
+    {0x2F93B, 0x24FA1}, {0x2F93C, 0x24FB8}, {0x2F93D, 0x25044}, {0x2F93E, 0x03FFC}, {0x2F93F, 0x04008}, {0x2F940, 0x076F4}, {0x2F941, 0x250F3}, {0x2F942, 0x250F2},
+    {0x2F943, 0x25119}, {0x2F944, 0x25133}, {0x2F945, 0x0771E}, {0x2F946, 0x0771F}, {0x2F947, 0x0771F}, {0x2F948, 0x0774A}, {0x2F949, 0x04039}, {0x2F94A, 0x0778B},
+    {0x2F94B, 0x04046}, {0x2F94C, 0x04096}, {0x2F94D, 0x2541D}, {0x2F94E, 0x0784E}, {0x2F94F, 0x0788C}, {0x2F950, 0x078CC}, {0x2F951, 0x040E3}, {0x2F952, 0x25626},
+    {0x2F953, 0x07956}, {0x2F954, 0x2569A}, {0x2F955, 0x256C5}, {0x2F956, 0x0798F}, {0x2F957, 0x079EB}, {0x2F958, 0x0412F}, {0x2F959, 0x07A40}, {0x2F95A, 0x07A4A},
+    {0x2F95B, 0x07A4F}, {0x2F95C, 0x2597C}, {0x2F95D, 0x25AA7}, {0x2F95E, 0x25AA7}, {0x2F95F, 0x07AEE}, {0x2F960, 0x04202}, {0x2F961, 0x25BAB}, {0x2F962, 0x07BC6},
+    {0x2F963, 0x07BC9}, {0x2F964, 0x04227}, {0x2F965, 0x25C80}, {0x2F966, 0x07CD2}, {0x2F967, 0x042A0}, {0x2F968, 0x07CE8}, {0x2F969, 0x07CE3}, {0x2F96A, 0x07D00},
+    {0x2F96B, 0x25F86}, {0x2F96C, 0x07D63}, {0x2F96D, 0x04301}, {0x2F96E, 0x07DC7}, {0x2F96F, 0x07E02}, {0x2F970, 0x07E45}, {0x2F971, 0x04334}, {0x2F972, 0x26228},
+    {0x2F973, 0x26247}, {0x2F974, 0x04359}, {0x2F975, 0x262D9}, {0x2F976, 0x07F7A}, {0x2F977, 0x2633E}, {0x2F978, 0x07F95}, {0x2F979, 0x07FFA}, {0x2F97A, 0x08005},
+    {0x2F97B, 0x264DA}, {0x2F97C, 0x26523}, {0x2F97D, 0x08060}, {0x2F97E, 0x265A8}, {0x2F97F, 0x08070}, {0x2F980, 0x2335F}, {0x2F981, 0x043D5}, {0x2F982, 0x080B2},
+    {0x2F983, 0x08103}, {0x2F984, 0x0440B}, {0x2F985, 0x0813E}, {0x2F986, 0x05AB5}, {0x2F987, 0x267A7}, {0x2F988, 0x267B5}, {0x2F989, 0x23393}, {0x2F98A, 0x2339C},
+    {0x2F98B, 0x08201}, {0x2F98C, 0x08204}, {0x2F98D, 0x08F9E}, {0x2F98E, 0x0446B}, {0x2F98F, 0x08291}, {0x2F990, 0x0828B}, {0x2F991, 0x0829D}, {0x2F992, 0x052B3},
+    {0x2F993, 0x082B1}, {0x2F994, 0x082B3}, {0x2F995, 0x082BD}, {0x2F996, 0x082E6}, {0x2F997, 0x26B3C}, {0x2F998, 0x082E5}, {0x2F999, 0x0831D}, {0x2F99A, 0x08363},
+    {0x2F99B, 0x083AD}, {0x2F99C, 0x08323}, {0x2F99D, 0x083BD}, {0x2F99E, 0x083E7}, {0x2F99F, 0x08457}, {0x2F9A0, 0x08353}, {0x2F9A1, 0x083CA}, {0x2F9A2, 0x083CC},
+    {0x2F9A3, 0x083DC}, {0x2F9A4, 0x26C36}, {0x2F9A5, 0x26D6B}, {0x2F9A6, 0x26CD5}, {0x2F9A7, 0x0452B}, {0x2F9A8, 0x084F1}, {0x2F9A9, 0x084F3}, {0x2F9AA, 0x08516},
+    {0x2F9AB, 0x273CA}, {0x2F9AC, 0x08564}, {0x2F9AD, 0x26F2C}, {0x2F9AE, 0x0455D}, {0x2F9AF, 0x04561}, {0x2F9B0, 0x26FB1}, {0x2F9B1, 0x270D2}, {0x2F9B2, 0x0456B},
+    {0x2F9B3, 0x08650}, {0x2F9B4, 0x0865C}, {0x2F9B5, 0x08667}, {0x2F9B6, 0x08669}, {0x2F9B7, 0x086A9}, {0x2F9B8, 0x08688}, {0x2F9B9, 0x0870E}, {0x2F9BA, 0x086E2},
+    {0x2F9BB, 0x08779}, {0x2F9BC, 0x08728}, {0x2F9BD, 0x0876B}, {0x2F9BE, 0x08786}, {0x2F9BF, 0x045D7}, {0x2F9C0, 0x087E1}, {0x2F9C1, 0x08801}, {0x2F9C2, 0x045F9},
+    {0x2F9C3, 0x08860}, {0x2F9C4, 0x08863}, {0x2F9C5, 0x27667}, {0x2F9C6, 0x088D7}, {0x2F9C7, 0x088DE}, {0x2F9C8, 0x04635}, {0x2F9C9, 0x088FA}, {0x2F9CA, 0x034BB},
+    {0x2F9CB, 0x278AE}, {0x2F9CC, 0x27966}, {0x2F9CD, 0x046BE}, {0x2F9CE, 0x046C7}, {0x2F9CF, 0x08AA0}, {0x2F9D0, 0x08AED}, {0x2F9D1, 0x08B8A}, {0x2F9D2, 0x08C55},
+    {0x2F9D3, 0x27CA8}, {0x2F9D4, 0x08CAB}, {0x2F9D5, 0x08CC1}, {0x2F9D6, 0x08D1B}, {0x2F9D7, 0x08D77}, {0x2F9D8, 0x27F2F}, {0x2F9D9, 0x20804}, {0x2F9DA, 0x08DCB},
+    {0x2F9DB, 0x08DBC}, {0x2F9DC, 0x08DF0}, {0x2F9DD, 0x208DE}, {0x2F9DE, 0x08ED4}, {0x2F9DF, 0x08F38}, {0x2F9E0, 0x285D2}, {0x2F9E1, 0x285ED}, {0x2F9E2, 0x09094},
+    {0x2F9E3, 0x090F1}, {0x2F9E4, 0x09111}, {0x2F9E5, 0x2872E}, {0x2F9E6, 0x0911B}, {0x2F9E7, 0x09238}, {0x2F9E8, 0x092D7}, {0x2F9E9, 0x092D8}, {0x2F9EA, 0x0927C},
+    {0x2F9EB, 0x093F9}, {0x2F9EC, 0x09415}, {0x2F9ED, 0x28BFA}, {0x2F9EE, 0x0958B}, {0x2F9EF, 0x04995}, {0x2F9F0, 0x095B7}, {0x2F9F1, 0x28D77}, {0x2F9F2, 0x049E6},
+    {0x2F9F3, 0x096C3}, {0x2F9F4, 0x05DB2}, {0x2F9F5, 0x09723}, {0x2F9F6, 0x29145}, {0x2F9F7, 0x2921A}, {0x2F9F8, 0x04A6E}, {0x2F9F9, 0x04A76}, {0x2F9FA, 0x097E0},
+    {0x2F9FB, 0x2940A}, {0x2F9FC, 0x04AB2}, {0x2F9FD, 0x29496}, {0x2F9FE, 0x0980B}, {0x2F9FF, 0x0980B}, {0x2FA00, 0x09829}, {0x2FA01, 0x295B6}, {0x2FA02, 0x098E2},
+    {0x2FA03, 0x04B33}, {0x2FA04, 0x09929}, {0x2FA05, 0x099A7}, {0x2FA06, 0x099C2}, {0x2FA07, 0x099FE}, {0x2FA08, 0x04BCE}, {0x2FA09, 0x29B30}, {0x2FA0A, 0x09B12},
+    {0x2FA0B, 0x09C40}, {0x2FA0C, 0x09CFD}, {0x2FA0D, 0x04CCE}, {0x2FA0E, 0x04CED}, {0x2FA0F, 0x09D67}, {0x2FA10, 0x2A0CE}, {0x2FA11, 0x04CF8}, {0x2FA12, 0x2A105},
+    {0x2FA13, 0x2A20E}, {0x2FA14, 0x2A291}, {0x2FA15, 0x09EBB}, {0x2FA16, 0x04D56}, {0x2FA17, 0x09EF9}, {0x2FA18, 0x09EFE}, {0x2FA19, 0x09F05}, {0x2FA1A, 0x09F0F},
+    {0x2FA1B, 0x09F16}, {0x2FA1C, 0x09F3B}, {0x2FA1D, 0x2A600},
+};
+
+// mapped to several code points
+struct bert_unicode_multi_entry
+{
+    uint32_t cp;
+    const char * utf8;
+};
+
+static const bert_unicode_multi_entry bert_unicode_multi[] = {
+    {0x009CB, "\xe0\xa7\x87\xe0\xa6\xbe"}, {0x009CC, "\xe0\xa7\x87\xe0\xa7\x97"}, {0x00B4B, "\xe0\xad\x87\xe0\xac\xbe"}, {0x00B4C, "\xe0\xad\x87\xe0\xad\x97"},
+    {0x00B94, "\xe0\xae\x92\xe0\xaf\x97"}, {0x00BCA, "\xe0\xaf\x86\xe0\xae\xbe"}, {0x00BCB, "\xe0\xaf\x87\xe0\xae\xbe"}, {0x00BCC, "\xe0\xaf\x86\xe0\xaf\x97"},
+    {0x00CCB, "\xe0\xb3\x82\xe0\xb3\x95"}, {0x00D4A, "\xe0\xb5\x86\xe0\xb4\xbe"}, {0x00D4B, "\xe0\xb5\x87\xe0\xb4\xbe"}, {0x00D4C, "\xe0\xb5\x86\xe0\xb5\x97"},
+    {0x00DDC, "\xe0\xb7\x99\xe0\xb7\x8f"}, {0x00DDD, "\xe0\xb7\x99\xe0\xb7\x8f"}, {0x00DDE, "\xe0\xb7\x99\xe0\xb7\x9f"}, {0x01B06, "\xe1\xac\x85\xe1\xac\xb5"},
+    {0x01B08, "\xe1\xac\x87\xe1\xac\xb5"}, {0x01B0A, "\xe1\xac\x89\xe1\xac\xb5"}, {0x01B0C, "\xe1\xac\x8b\xe1\xac\xb5"}, {0x01B0E, "\xe1\xac\x8d\xe1\xac\xb5"},
+    {0x01B12, "\xe1\xac\x91\xe1\xac\xb5"}, {0x01B40, "\xe1\xac\xbe\xe1\xac\xb5"}, {0x01B41, "\xe1\xac\xbf\xe1\xac\xb5"}, {0x1134B, "\xf0\x91\x8d\x87\xf0\x91\x8c\xbe"},
+    {0x1134C, "\xf0\x91\x8d\x87\xf0\x91\x8d\x97"}, {0x114BC, "\xf0\x91\x92\xb9\xf0\x91\x92\xb0"}, {0x114BE, "\xf0\x91\x92\xb9\xf0\x91\x92\xbd"}, {0x115BA, "\xf0\x91\x96\xb8\xf0\x91\x96\xaf"},
+    {0x115BB, "\xf0\x91\x96\xb9\xf0\x91\x96\xaf"}, {0x11938, "\xf0\x91\xa4\xb5\xf0\x91\xa4\xb0"}, {0x1D15E, "\xf0\x9d\x85\x97\xf0\x9d\x85\xa5"}, {0x1D15F, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5"},
+    {0x1D160, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5\xf0\x9d\x85\xae"}, {0x1D161, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5\xf0\x9d\x85\xaf"}, {0x1D162, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5\xf0\x9d\x85\xb0"}, {0x1D163, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5\xf0\x9d\x85\xb1"},
+    {0x1D164, "\xf0\x9d\x85\x98\xf0\x9d\x85\xa5\xf0\x9d\x85\xb2"}, {0x1D1BB, "\xf0\x9d\x86\xb9\xf0\x9d\x85\xa5"}, {0x1D1BC, "\xf0\x9d\x86\xba\xf0\x9d\x85\xa5"}, {0x1D1BD, "\xf0\x9d\x86\xb9\xf0\x9d\x85\xa5\xf0\x9d\x85\xae"},
+    {0x1D1BE, "\xf0\x9d\x86\xba\xf0\x9d\x85\xa5\xf0\x9d\x85\xae"}, {0x1D1BF, "\xf0\x9d\x86\xb9\xf0\x9d\x85\xa5\xf0\x9d\x85\xaf"}, {0x1D1C0, "\xf0\x9d\x86\xba\xf0\x9d\x85\xa5\xf0\x9d\x85\xaf"},
+};